@@ -0,0 +1,26 @@
+# ==============================================================================
+#  yml2cpp_embed(<target> <input.yml> <name> [NAMESPACE <namespace>])
+#
+#  Freezes a YML file into <name>.h at build time (see tools/yml2cpp), and
+#  lets <target> include it as "<name>.h". The header is regenerated whenever
+#  the YML file, or the generator itself, changes.
+# ==============================================================================
+function(yml2cpp_embed TARGET INPUT NAME)
+    cmake_parse_arguments(ARG "" "NAMESPACE" "" ${ARGN})
+
+    get_filename_component(INPUT_PATH ${INPUT} ABSOLUTE)
+    set(OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/yml2cpp)
+    set(OUTPUT ${OUTPUT_DIR}/${NAME}.h)
+
+    add_custom_command(
+        OUTPUT ${OUTPUT}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_DIR}
+        COMMAND yml2cpp ${INPUT_PATH} ${OUTPUT} ${NAME} ${ARG_NAMESPACE}
+        DEPENDS yml2cpp ${INPUT_PATH}
+        COMMENT "Embedding ${INPUT} as ${NAME}.h"
+        VERBATIM
+    )
+
+    target_sources(${TARGET} PRIVATE ${OUTPUT})
+    target_include_directories(${TARGET} PRIVATE ${OUTPUT_DIR})
+endfunction()
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "yml/Yml.h"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace yml
+{
+
+    /**
+     * @brief   Outcome of loading a single file through loadAll().
+     *
+     * When the file could not be loaded, yml is left empty and error holds
+     * the exception that was thrown while loading it.
+     */
+    struct LoadResult
+    {
+        std::string filepath;
+        Yml yml;
+        std::exception_ptr error;
+
+        /**
+         * @returns True if the file was loaded and parsed successfully.
+         */
+        [[nodiscard]] bool ok() const { return this->error == nullptr; }
+
+        /**
+         * @brief   Rethrows the exception stored in error, if any.
+         */
+        void rethrow() const;
+    };
+
+    /**
+     * @brief   Runs fn(i) for every i in [0, count) on a pool of worker
+     *          threads.
+     *
+     * Indices are handed out dynamically, so a slow item does not hold back
+     * the rest of the pool. The calling thread takes part in the work.
+     * fn must not throw.
+     *
+     * @param   count   Number of items to process
+     * @param   threads Maximum number of threads to use. 0 means
+     *                  std::thread::hardware_concurrency().
+     * @param   fn      The function to call for every index
+     * @throws  std::system_error   If a thread could not be started. The
+     *                              items already handed out are completed,
+     *                              the others are not processed.
+     */
+    void parallelFor(
+        size_t count,
+        size_t threads,
+        const std::function<void(size_t)>& fn
+    );
+
+    /**
+     * @brief   Loads several files concurrently.
+     *
+     * Each file is read and parsed on one of the worker threads. Errors are
+     * reported per file in the matching LoadResult: a file that fails to
+     * load does not abort the rest of the batch.
+     *
+     * @param   filepaths       The paths of the files to load
+     * @param   threads         Maximum number of threads to use. 0 means
+     *                          std::thread::hardware_concurrency().
+     * @param   nestingLevel    The number of spaces used to represent one
+     *                          level of nesting. Defaults to
+     *                          YML_NESTING_SPACES.
+     * @param   resource        The memory resource shared by every document
+     *                          of the batch. Used from several threads at
+     *                          once, so it must be thread-safe (e.g. a
+     *                          std::pmr::synchronized_pool_resource).
+     * @returns One LoadResult per path, in the same order as filepaths.
+     * @throws  std::system_error   If a worker thread could not be started
+     */
+    std::vector<LoadResult> loadAll(
+        const std::vector<std::string>& filepaths,
+        size_t threads = 0,
+        uint8_t nestingLevel = YML_NESTING_SPACES,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    );
+
+    /**
+     * @brief   Loads a file in the background.
+     *
+     * The file is parsed on a new thread while another one reads it, see
+     * Yml::loadFromFilepath(const std::string&, uint8_t, io::Backend).
+     *
+     * @param   filepath        The path to the file to load
+     * @param   backend         How to read the file. Falls back to
+     *                          io::Backend::BLOCKING if unavailable.
+     * @param   nestingLevel    The number of spaces used to represent one
+     *                          level of nesting. Defaults to
+     *                          YML_NESTING_SPACES.
+     * @param   resource        The memory resource to allocate the document
+     *                          from. Must outlive the document.
+     * @returns The document, or the exception thrown while loading it.
+     */
+    std::future<Yml> loadAsync(
+        std::string filepath,
+        io::Backend backend = io::Backend::BLOCKING,
+        uint8_t nestingLevel = YML_NESTING_SPACES,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    );
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "yml/Yml.h"
+
+#include <string>
+#include <vector>
+
+namespace yml
+{
+
+    /**
+     * @brief   Structural differences between two documents.
+     *
+     * Paths are dotted, like the ones taken by Yml::getNode(), and sorted.
+     */
+    struct Diff
+    {
+        std::vector<std::string> added;     /// Only in the new document
+        std::vector<std::string> removed;   /// Only in the old document
+        std::vector<std::string> changed;   /// In both, with another value or type
+
+        [[nodiscard]] bool empty() const
+        {
+            return this->added.empty() && this->removed.empty() && this->changed.empty();
+        }
+    };
+
+    /**
+     * @brief   Computes the differences between two trees.
+     *
+     * Subtrees whose fingerprints match are skipped without being walked, so
+     * the cost grows with the size of the change rather than with the size
+     * of the trees. An added or removed node is reported once, not along with
+     * its whole subtree.
+     *
+     * @param   oldTree The reference tree
+     * @param   newTree The tree to compare to oldTree
+     * @returns The differences, from oldTree to newTree
+     */
+    Diff diff(const Tree& oldTree, const Tree& newTree);
+
+    /**
+     * @brief   Computes the differences between two documents.
+     *
+     * @param   oldDoc  The reference document
+     * @param   newDoc  The document to compare to oldDoc
+     * @returns The differences, from oldDoc to newDoc
+     */
+    inline Diff diff(const Yml& oldDoc, const Yml& newDoc)
+    {
+        return diff(oldDoc.getTree(), newDoc.getTree());
+    }
+
+}
@@ -7,7 +7,7 @@ namespace yml::exception
 {
 
     class CouldNotOpenFile final
-        : std::runtime_error
+        : public std::runtime_error
     {
     public:
         explicit CouldNotOpenFile(const std::string& filepath)
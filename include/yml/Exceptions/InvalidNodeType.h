@@ -7,7 +7,7 @@ namespace yml::exception
 {
 
     class InvalidNodeType final
-        : std::runtime_error
+        : public std::runtime_error
     {
     public:
         explicit InvalidNodeType(
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <format>
+#include <stdexcept>
+
+namespace yml::exception
+{
+
+    class InvalidQuery final
+        : public std::runtime_error
+    {
+    public:
+        explicit InvalidQuery(
+            const std::string& query,
+            const std::string& reason
+        )
+            : std::runtime_error(std::format(
+                "{} - {}: Invalid query.",
+                query, reason
+            ))
+        {}
+    };
+
+}
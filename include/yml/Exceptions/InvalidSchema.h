@@ -0,0 +1,24 @@
+#pragma once
+
+#include <format>
+#include <stdexcept>
+
+namespace yml::exception
+{
+
+    class InvalidSchema final
+        : public std::runtime_error
+    {
+    public:
+        explicit InvalidSchema(
+            const std::string& path,
+            const std::string& reason
+        )
+            : std::runtime_error(std::format(
+                "{} - {}: Invalid schema.",
+                path, reason
+            ))
+        {}
+    };
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <format>
+#include <stdexcept>
+
+namespace yml::exception
+{
+
+    class SchemaViolation final
+        : public std::runtime_error
+    {
+    public:
+        explicit SchemaViolation(
+            const std::string& path,
+            const std::string& reason,
+            const size_t line
+        )
+            : std::runtime_error(std::format(
+                "{} - {} (line {}): Schema violation.",
+                path, reason, line
+            ))
+        {}
+    };
+
+}
@@ -7,7 +7,7 @@ namespace yml::exception
 {
 
     class UnknownNodeType final
-        : std::runtime_error
+        : public std::runtime_error
     {
     public:
         explicit UnknownNodeType(
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "yml/Node.h"
+#include "yml/PerfectHash.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yml
+{
+
+    namespace frozen
+    {
+
+        /// Record::seedOffset of a mapping that has no perfect hash.
+        inline constexpr uint32_t NO_SEEDS = UINT32_MAX;
+
+        /**
+         * @brief   One node of a frozen document.
+         *
+         * All the records of a document live in a single array, the first one
+         * being the (unnamed) root. The children of a record are contiguous.
+         * Each mapping has a minimal perfect hash over its children's names,
+         * whose seeds start at seedOffset in the seed table, and its children
+         * are stored in slot order. Lists keep their children in order.
+         * Subtrees shared through aliases are stored once, every alias
+         * pointing to the same children. Names and values are offsets into a
+         * single character blob.
+         */
+        struct Record
+        {
+            uint32_t nameOffset;
+            uint32_t nameSize;
+            uint32_t valueOffset;
+            uint32_t valueSize;
+            uint32_t firstChild;
+            uint32_t childCount;
+            uint32_t seedOffset;
+            node::Type type;
+            bool isList;
+        };
+
+        /**
+         * @brief   The three tables a frozen document is made of.
+         */
+        struct View
+        {
+            const Record* records;
+            const char* blob;
+            const uint32_t* seeds;
+        };
+
+    }
+
+    /**
+     * @brief   Read-only handle on a node of a frozen document.
+     *
+     * Cheap to copy. Offers the same read API as Node (operator[] and as<T>),
+     * on top of a frozen::View. The handle does not own the tables: it must
+     * not outlive the FrozenYml (or the static data) it comes from.
+     */
+    class FrozenNode final
+    {
+    public:
+        constexpr FrozenNode(
+            const frozen::View view,
+            const uint32_t index = 0
+        )
+            : _view(view), _index(index)
+        {}
+
+        [[nodiscard]] constexpr std::string_view name() const
+        {
+            return { this->_view.blob + this->record().nameOffset, this->record().nameSize };
+        }
+
+        [[nodiscard]] constexpr std::string_view value() const
+        {
+            return { this->_view.blob + this->record().valueOffset, this->record().valueSize };
+        }
+
+        [[nodiscard]] constexpr node::Type type() const { return this->record().type; }
+
+        [[nodiscard]] constexpr bool isList() const { return this->record().isList; }
+
+        /**
+         * @returns The number of children of the node.
+         */
+        [[nodiscard]] constexpr size_t size() const { return this->record().childCount; }
+
+        /**
+         * @brief   Looks a child up by name.
+         *
+         * Takes a single probe through the perfect hash of the node. Falls
+         * back to a linear scan for the rare mappings that have none.
+         *
+         * @param   name    The name of the child to look for
+         * @returns The child, or std::nullopt if there is none.
+         */
+        [[nodiscard]] constexpr std::optional<FrozenNode> find(const std::string_view name) const noexcept
+        {
+            const frozen::Record& r = this->record();
+
+            if (r.childCount == 0) {
+                return std::nullopt;
+            }
+
+            if (r.seedOffset != frozen::NO_SEEDS) {
+                const FrozenNode child(this->_view, static_cast<uint32_t>(
+                    r.firstChild + PerfectHash::slot(name, this->_view.seeds + r.seedOffset, r.childCount)
+                ));
+
+                if (child.name() == name) {
+                    return child;
+                }
+                return std::nullopt;
+            }
+
+            for (uint32_t i = r.firstChild; i < r.firstChild + r.childCount; ++i) {
+                if (FrozenNode(this->_view, i).name() == name) {
+                    return FrozenNode(this->_view, i);
+                }
+            }
+            return std::nullopt;
+        }
+
+        template<typename T = std::string>
+        T as()
+            const
+        {
+            return node::convert<T>(this->name(), this->value(), this->type());
+        }
+
+        template<typename T = std::string>
+        [[nodiscard]] std::optional<T> tryAs()
+            const noexcept(!std::is_same_v<T, std::string>)
+        {
+            return node::tryConvert<T>(this->value(), this->type());
+        }
+
+        /**
+         * @brief   Converts the values of all the children to numbers, see
+         *          Node::copyTo().
+         */
+        template<typename T>
+        node::BulkResult copyTo(const std::span<T> out)
+            const noexcept
+        {
+            const frozen::Record* const children = this->_view.records + this->record().firstChild;
+
+            return node::convertAll(this->size(), [this, children](const size_t i) -> std::string_view {
+                return { this->_view.blob + children[i].valueOffset, children[i].valueSize };
+            }, out);
+        }
+
+        /**
+         * @brief   Converts the values of all the children to numbers, see
+         *          Node::asVector().
+         */
+        template<typename T>
+        std::vector<T> asVector()
+            const
+        {
+            std::vector<T> result(this->size());
+            const node::BulkResult status = this->copyTo(std::span<T>(result));
+
+            if (!status.ok()) {
+                node::throwBulkError<T>(this->name(), status);
+            }
+            return result;
+        }
+
+        /**
+         * @brief   Accesses a child node by its name.
+         *
+         * @param   name    The name of the child Node to access
+         * @returns A handle on the corresponding child Node
+         * @throws  std::out_of_range   If there is no such child
+         */
+        constexpr FrozenNode operator[](const std::string_view name) const
+        {
+            const auto child = this->find(name);
+
+            if (!child) {
+                throw std::out_of_range("No such node: " + std::string(name));
+            }
+            return *child;
+        }
+
+        /**
+         * @brief   Accesses a child node by its index, in storage order
+         *          (insertion order for lists).
+         *
+         * @param   index   The zero-based index of the child Node to access
+         * @returns A handle on the corresponding child Node
+         * @throws  std::out_of_range   If index is out of range
+         */
+        constexpr FrozenNode operator[](const size_t index) const
+        {
+            if (index >= this->size()) {
+                throw std::out_of_range("Index out of range in FrozenNode");
+            }
+            return { this->_view, static_cast<uint32_t>(this->record().firstChild + index) };
+        }
+
+    private:
+        frozen::View _view;
+        uint32_t _index;
+
+        [[nodiscard]] constexpr const frozen::Record& record() const { return this->_view.records[this->_index]; }
+    };
+
+    /**
+     * @brief   Immutable, compact copy of a parsed document.
+     *
+     * Built once from a Tree (see Yml::freeze()). Nodes are stored
+     * breadth-first in a single array, so siblings are contiguous in memory,
+     * every distinct string is stored once in a single blob, and every
+     * mapping gets a minimal perfect hash.
+     */
+    class FrozenYml final
+    {
+    public:
+        /**
+         * @brief   Freezes a tree.
+         *
+         * @param   tree    The tree to copy
+         * @throws  std::length_error   If the document does not fit 32-bit
+         *                              offsets
+         */
+        explicit FrozenYml(const Tree& tree);
+
+        [[nodiscard]] FrozenNode root() const
+        {
+            return frozen::View{ this->_records.data(), this->_blob.data(), this->_seeds.data() };
+        }
+
+        /**
+         * @brief   Retrieves a node by its dotted path (e.g. "server.port").
+         *
+         * @param   search  The path of the node to look for
+         * @returns The node, or std::nullopt if not found.
+         */
+        [[nodiscard]] std::optional<FrozenNode> getNode(std::string_view search) const;
+
+        /**
+         * @returns The number of bytes used by the document tables.
+         */
+        [[nodiscard]] size_t footprint() const;
+
+        FrozenNode operator[](const std::string_view name) const { return this->root()[name]; }
+
+        /**
+         * @brief   The tables of the document, e.g. to embed them as static
+         *          data (see tools/yml2cpp).
+         */
+        [[nodiscard]] std::span<const frozen::Record> getRecords() const { return this->_records; }
+
+        [[nodiscard]] std::span<const char> getBlob() const { return this->_blob; }
+
+        [[nodiscard]] std::span<const uint32_t> getSeeds() const { return this->_seeds; }
+
+    private:
+        std::vector<frozen::Record> _records;
+        std::vector<char> _blob;
+        std::vector<uint32_t> _seeds;
+    };
+
+}
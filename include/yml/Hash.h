@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Stable 64-bit hashing primitives.
+ *
+ * Unlike std::hash, results do not depend on the platform or on the run, so
+ * they can be stored or compared across processes.
+ */
+namespace yml::hash
+{
+
+    /**
+     * @brief   FNV-1a hash of a string.
+     */
+    constexpr uint64_t string(const std::string_view str) noexcept
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+
+        for (const char c : str) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief   Scrambles a hash with a seed (splitmix64 finalizer).
+     */
+    constexpr uint64_t mix(uint64_t h, const uint64_t seed = 0) noexcept
+    {
+        h += (seed + 1) * 0x9e3779b97f4a7c15ULL;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief   Combines two hashes. Order matters.
+     */
+    constexpr uint64_t combine(const uint64_t seed, const uint64_t h) noexcept
+    {
+        return mix(seed ^ h, seed);
+    }
+
+}
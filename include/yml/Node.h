@@ -4,57 +4,259 @@
 
 #include "yml/Exceptions/InvalidNodeType.h"
 #include "yml/Exceptions/UnknownNodeType.h"
+#include "yml/PerfectHash.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 namespace yml
 {
 
     struct Node; /// Forward declaration so that Tree can reference it
 
+    /**
+     * @brief   Transparent string hash.
+     *
+     * Lets the node maps be searched with a std::string_view or a
+     * const char* without building a std::string first.
+     */
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const std::string_view str) const noexcept
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
 
     /**
      * @brief   Represents a container of named child nodes.
      *
      * The Tree class manages a collection of Node objects, enabling
      * hierarchical storage and retrieval by name.
+     *
+     * Nodes are stored contiguously, in insertion order. List items may share
+     * a name; other nodes may not, and only the first one added is kept.
+     *
+     * A tree can also be a view of an immutable subtree shared with other
+     * trees (see share()), as done for YML anchors and aliases. Reads go
+     * through to the shared subtree. The first change made through the Tree
+     * API, or the first non-const access to one of its nodes, gives the tree
+     * its own copy. Read through a const tree to keep sharing.
+     *
+     * Every node of the tree, and every string they hold, is allocated from
+     * the memory resource of the tree.
      */
     class Tree final
     {
     public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+        using Children = std::pmr::vector<Node>;
+
+        /**
+         * @brief   Trees with at least this many named (non list item)
+         *          children look names up through a hash index rather than
+         *          a linear scan.
+         */
+        static constexpr size_t INDEX_THRESHOLD = 8;
+
+        Tree() = default;
+
+        explicit Tree(const allocator_type& alloc)
+            : _children(alloc)
+        {}
+
         /**
-         * @brief   Adds a Node to the tree.
+         * @brief   Copies the nodes of another tree.
+         *
+         * The copy is never sealed, even if other is.
+         *
+         * @param   other   The tree to copy
+         * @param   alloc   The allocator of the copy. Defaults to the default
+         *                  memory resource, as for any std::pmr container.
+         */
+        Tree(const Tree& other, const allocator_type& alloc = {});
+
+        Tree(Tree&& other) noexcept;
+
+        /**
+         * @brief   Moves the nodes of another tree to a given allocator.
+         *
+         * The tree stays sealed only if alloc is the allocator of other.
+         */
+        Tree(Tree&& other, const allocator_type& alloc);
+
+        Tree& operator=(const Tree& other);
+        Tree& operator=(Tree&& other);
+
+        ~Tree();
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return this->_children.get_allocator(); }
+
+        /**
+         * @brief   Adds a copy of a Node to the tree.
+         *
+         * Unseals the tree. May invalidate references to the nodes of the
+         * tree, as for a std::vector.
          *
          * @param   node    Reference to the Node to be added
+         * @returns The node stored in the tree: the new one, or the one that
+         *          already had the same name.
+         */
+        Node& addNode(const Node& node);
+
+        /**
+         * @brief   Moves a Node into the tree.
+         *
+         * Unseals the tree. May invalidate references to the nodes of the
+         * tree, as for a std::vector.
+         *
+         * @param   node    The Node to be added
+         * @returns The node stored in the tree: the new one, or the one that
+         *          already had the same name.
          */
-        void addNode(Node& node);
+        Node& addNode(Node&& node);
+
+        /**
+         * @brief   Reserves room for a number of children, so that adding
+         *          them does not move the nodes already there.
+         */
+        void reserve(size_t count);
+
+        /**
+         * @brief   Removes a child, looked up as by find().
+         *
+         * May invalidate references to the nodes of the tree, as for a
+         * std::vector.
+         *
+         * @param   name    The name of the child to remove
+         * @returns False if there was no such child.
+         */
+        bool erase(std::string_view name);
 
         /**
          * @brief   Retrieves all child nodes stored in the tree.
          *
-         * @returns Const reference to an unordered map containing all child
-         *          Nodes.
+         * @returns Const reference to the child Nodes, in insertion order.
+         */
+        [[nodiscard]] const Children&
+            getNodes() const { return this->self()._children; }
+
+        [[nodiscard]] size_t size() const noexcept { return this->self()._children.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return this->self()._children.empty(); }
+
+        /**
+         * @brief   Turns the children into an immutable subtree, that other
+         *          trees can view without copying it.
+         *
+         * The tree becomes a view of that subtree. Calling it again returns
+         * the same subtree.
+         *
+         * @returns The shared subtree
+         */
+        std::shared_ptr<const Tree> share();
+
+        /**
+         * @brief   Makes the tree a view of a shared subtree, dropping its own
+         *          children.
+         *
+         * @param   shared  The subtree to view, as returned by share(). May
+         *                  also point into a document kept alive by the
+         *                  pointer, through the std::shared_ptr aliasing
+         *                  constructor. Must not change while viewed.
          */
-        [[nodiscard]] const std::unordered_map<std::string, Node>&
-            getNodes() const { return this->_children; }
+        void view(std::shared_ptr<const Tree> shared);
+
+        /**
+         * @brief   Gives the tree its own copy of the subtree it views, if
+         *          any.
+         *
+         * Only the children are copied: their own children become views of
+         * the shared subtree, detached in turn when they are changed.
+         *
+         * Done by addNode(), reserve() and nuke(). The nodes of a shared
+         * subtree must not be modified in place: call this first.
+         */
+        void detach();
+
+        [[nodiscard]] bool isShared() const noexcept { return this->_shared != nullptr; }
 
         /**
          * @brief   Clears all child nodes in the tree. Used to reset the Yml
          *          instance.
          */
-        void nuke() { this->_children.clear(); }
+        void nuke();
+
+        /**
+         * @brief   Marks the tree and all of its subtrees as read-only.
+         *
+         * Builds a minimal perfect hash over the names of every indexed
+         * mapping, so that lookups by name take a single probe. Adding a node
+         * to a sealed tree unseals it again.
+         */
+        void seal();
+
+        [[nodiscard]] bool isSealed() const { return this->_sealed; }
+
+        /**
+         * @brief   Fingerprint of the children of the tree.
+         *
+         * Depends on the position of list items, but not on the order of the
+         * other children. Computed on first request and cached until the
+         * tree, or one of its subtrees, changes.
+         *
+         * Computing it writes to the cache, so it must not be called from
+         * several threads at once on a tree that was modified since the last
+         * call. Trees loaded by the Parser come with their fingerprints
+         * already computed.
+         *
+         * Writes to the public fields of the nodes are not tracked: see
+         * Node::hash().
+         */
+        [[nodiscard]] uint64_t hash() const noexcept;
+
+        /**
+         * @brief   Drops the cached fingerprint of the tree and of the nodes
+         *          above it.
+         *
+         * Called by every member function that modifies the tree.
+         */
+        void invalidateHash() noexcept;
+
+        /**
+         * @brief   Compares two trees by fingerprint.
+         *
+         * Barring a 64-bit collision, trees are equal if they hold equal
+         * nodes, with list items in the same order.
+         */
+        [[nodiscard]] bool operator==(const Tree& other) const noexcept
+        {
+            return this->size() == other.size() && this->hash() == other.hash();
+        }
 
         /**
          * @brief   Accesses a child node by its name.
          *
          * This operator allows access to a specific Node in the tree by
-         * providing its name.
+         * providing its name. Detaches a view first, see detach().
          *
          * @param   name    The name of the Node to access
          * @return  A reference to the corresponding Node
+         * @throws  std::out_of_range   If there is no such Node
          */
-        Node& operator[](const std::string& name);
+        Node& operator[](std::string_view name);
 
         /**
          * @brief   Accesses a child node by its name (const version).
@@ -64,18 +266,43 @@ namespace yml
          *
          * @param   name    The name of the Node to access
          * @return  A const reference to the corresponding Node
+         * @throws  std::out_of_range   If there is no such Node
+         */
+        const Node& operator[](std::string_view name) const;
+
+        /**
+         * @brief   Looks a child node up by its name.
+         *
+         * Among list items sharing a name, the first one is found. If it is
+         * found in a view, the view is detached first, see detach().
+         *
+         * @param   name    The name of the Node to look for
+         * @returns An optional reference to the found Node, or std::nullopt if
+         *          not found.
          */
-        const Node& operator[](const std::string& name) const;
+        [[nodiscard]] std::optional<std::reference_wrapper<Node>>
+            find(std::string_view name);
+
+        /**
+         * @brief   Looks a child node up by its name, without throwing (const
+         *          version).
+         *
+         * @param   name    The name of the Node to look for
+         * @returns An optional reference to the found Node, or std::nullopt if
+         *          not found.
+         */
+        [[nodiscard]] std::optional<std::reference_wrapper<const Node>>
+            find(std::string_view name) const noexcept;
 
         /**
          * @brief   Accesses a child node by its index.
          *
          * This operator allows access to a Node based on its position in the
-         * insertion order. Since the underlying container is an unordered_map,
-         * the order is not guaranteed to be stable across runs. FIXME!
+         * insertion order. Detaches a view first, see detach().
          *
          * @param   index   The zero-based index of the Node to access
          * @returns A reference to the corresponding Node
+         * @throws  std::out_of_range   If index is past the last Node
          */
         Node& operator[](size_t index);
 
@@ -87,11 +314,67 @@ namespace yml
          *
          * @param   index   The zero-based index of the Node to access
          * @return  A const reference to the corresponding Node
+         * @throws  std::out_of_range   If index is past the last Node
          */
         const Node& operator[](size_t index) const;
 
     private:
-        std::unordered_map<std::string, Node> _children;
+        friend struct Node;
+
+        struct Index; /// Hash index and perfect hash of the names, in Node.cpp
+
+        Children _children;
+        std::shared_ptr<const Tree> _shared;    /// Viewed subtree, if any
+        Index* _index = nullptr;                /// Null until the tree has INDEX_THRESHOLD names
+        Node* _owner = nullptr;                 /// Node whose children this is
+        mutable uint64_t _hash = 0;
+        mutable bool _hashed = false;
+        bool _sealed = false;
+
+        void unseal() noexcept;
+
+        /**
+         * @returns The tree holding the nodes: the viewed subtree, if any.
+         */
+        [[nodiscard]] const Tree& self() const noexcept { return this->_shared ? *this->_shared : *this; }
+
+        /**
+         * @brief   Points the children back to this tree, after they were
+         *          copied or moved in.
+         */
+        void adopt() noexcept;
+
+        /**
+         * @brief   Rebuilds the name index from scratch, if the tree has
+         *          enough names to need one.
+         */
+        void reindex();
+
+        void dropIndex() noexcept;
+
+        /**
+         * @brief   Finds a named child (not a list item).
+         *
+         * @returns The matching Node, or nullptr if there is none.
+         */
+        [[nodiscard]] Node* findName(std::string_view name) const noexcept;
+
+        /**
+         * @brief   Finds a child by name, list items included.
+         *
+         * @param   name    The name of the Node to look for
+         * @returns The matching Node, or nullptr if there is none.
+         */
+        [[nodiscard]] Node* lookup(std::string_view name) const noexcept;
+
+        /**
+         * @brief   Hands out a child found by lookup() for modification.
+         *
+         * @param   node    The child, possibly in the viewed subtree
+         * @returns The same child in the tree, detached first if it was a
+         *          view.
+         */
+        [[nodiscard]] Node& own(const Node& node);
     };
 
 
@@ -116,6 +399,192 @@ namespace yml
             UNKNOWN     // Fallback
         };
 
+        /**
+         * @brief   Converts a node value to T.
+         *
+         * Shared by every node representation that exposes as<T>().
+         *
+         * @param   name    Name of the node, used in error messages
+         * @param   value   Raw value of the node
+         * @param   type    Detected type of the node
+         * @returns The converted value
+         * @throws  exception::InvalidNodeType  If type does not match T
+         * @throws  exception::UnknownNodeType  If T is not supported
+         */
+        template<typename T = std::string>
+        T convert(
+            const std::string_view name,
+            const std::string_view value,
+            const Type type
+        )
+        {
+            IF_T_IS_TYPE(std::string) {
+                return std::string(value);
+            }
+            IF_T_IS_TYPE(int) {
+                if (type != INTEGER) {
+                    throw exception::InvalidNodeType(std::string(name), "INT");
+                }
+                return std::stoi(std::string(value));
+            }
+            IF_T_IS_TYPE(double) {
+                if (type != DOUBLE && type != INTEGER) {
+                    throw exception::InvalidNodeType(std::string(name), "FLOAT");
+                }
+                return std::stod(std::string(value));
+            }
+            IF_T_IS_TYPE(bool) {
+                if (type != BOOLEAN) {
+                    throw exception::InvalidNodeType(std::string(name), "BOOLEAN");
+                }
+                return value == "true" || value == "1";
+            }
+
+            throw exception::UnknownNodeType(std::string(name));
+        }
+
+        /**
+         * @brief   Converts a node value to T, without throwing.
+         *
+         * Numbers are read with std::from_chars rather than std::stoi and
+         * std::stod. The result is the same for the decimal values the parser
+         * types as numbers, but hexadecimal values such as `0x1.8` are read up
+         * to the `x`, where convert<T>() would read them whole.
+         *
+         * Only std::string results allocate. Allocating them may throw
+         * std::bad_alloc.
+         *
+         * @param   value   Raw value of the node
+         * @param   type    Detected type of the node
+         * @returns The converted value, or std::nullopt if type does not match
+         *          T, if T is not supported or if value does not fit in T.
+         */
+        template<typename T = std::string>
+        std::optional<T> tryConvert(
+            std::string_view value,
+            const Type type
+        ) noexcept(!std::is_same_v<T, std::string>)
+        {
+            IF_T_IS_TYPE(std::string) {
+                return std::string(value);
+            }
+            IF_T_IS_TYPE(bool) {
+                if (type != BOOLEAN) {
+                    return std::nullopt;
+                }
+                return value == "true" || value == "1";
+            }
+            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, double>) {
+                T result{};
+
+                if (type != INTEGER && (std::is_same_v<T, int> || type != DOUBLE)) {
+                    return std::nullopt;
+                }
+                if (value.starts_with('+')) {
+                    value.remove_prefix(1); // Accepted by stoi/stod, not by from_chars
+                    if (value.starts_with('-')) {
+                        return std::nullopt; // Two signs are not
+                    }
+                }
+                if (std::from_chars(value.data(), value.data() + value.size(), result).ec != std::errc()) {
+                    return std::nullopt;
+                }
+                return result;
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief   Outcome of a bulk conversion (see Node::copyTo()).
+         */
+        struct BulkResult
+        {
+            static constexpr size_t npos = SIZE_MAX;
+
+            size_t count = 0;   /// Number of values written
+            size_t bad = npos;  /// Index of the first value that could not be converted
+
+            [[nodiscard]] bool ok() const { return this->bad == npos; }
+        };
+
+        /**
+         * @brief   Parses a whole string as a number.
+         *
+         * Unlike tryConvert(), ignores the detected type of the node and
+         * rejects trailing characters, so it is enough to validate the value.
+         *
+         * @param   value   The string to parse
+         * @param   result  Set to the parsed number on success
+         * @returns True on success.
+         */
+        template<typename T>
+        bool parseNumber(
+            std::string_view value,
+            T& result
+        ) noexcept
+        {
+            static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Not a number type");
+
+            if (value.starts_with('+')) {
+                value.remove_prefix(1); // Accepted by stoi/stod, not by from_chars
+                if (value.starts_with('-')) {
+                    return false; // Two signs are not
+                }
+            }
+
+            const char* const end = value.data() + value.size();
+            const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+
+            return ec == std::errc() && ptr == end && !value.empty();
+        }
+
+        /**
+         * @brief   Converts a sequence of values to numbers, in one pass.
+         *
+         * Stops at the first value that is not a number.
+         *
+         * @param   size    Number of values
+         * @param   valueAt Returns the i-th value, as a std::string_view
+         * @param   out     Receives the numbers. Only the first
+         *                  min(size, out.size()) values are converted.
+         */
+        template<typename T, typename ValueAt>
+        BulkResult convertAll(
+            const size_t size,
+            const ValueAt& valueAt,
+            const std::span<T> out
+        ) noexcept
+        {
+            const size_t count = std::min(size, out.size());
+
+            for (size_t i = 0; i < count; ++i) {
+                if (!parseNumber(valueAt(i), out[i])) {
+                    return { i, i };
+                }
+            }
+            return { count };
+        }
+
+        /**
+         * @brief   Throws the error matching a failed bulk conversion to T.
+         *
+         * @param   name    Name of the converted node
+         * @param   result  The failed conversion
+         * @throws  exception::InvalidNodeType  Always
+         */
+        template<typename T>
+        [[noreturn]] void throwBulkError(
+            const std::string_view name,
+            const BulkResult& result
+        )
+        {
+            throw exception::InvalidNodeType(
+                std::string(name) + "[" + std::to_string(result.bad) + "]",
+                std::is_integral_v<T> ? "INT" : "FLOAT"
+            );
+        }
+
     }
 
     /**
@@ -124,11 +593,16 @@ namespace yml
      * A Node can hold a name, an optional value, and its own subtree
      * (children).
      * It also supports detecting list items (marked by "- " at the beginning).
+     *
+     * Node is allocator-aware: when stored in a Tree, it and its whole
+     * subtree use the memory resource of that Tree.
      */
     struct Node
     {
-        std::string name;
-        std::string value;
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        std::pmr::string name;
+        std::pmr::string value;
         bool isList = false;
         node::Type type = node::UNKNOWN;
         Tree children;
@@ -140,41 +614,125 @@ namespace yml
          *
          * @param   name    Name of the node
          * @param   value   Value of the node (can be empty)
+         * @param   alloc   Allocator of the node strings and children
          */
         Node(
-            const std::string& name,
-            const std::string& value
+            std::string_view name,
+            std::string_view value,
+            const allocator_type& alloc = {}
         );
 
+        Node(const Node& other, const allocator_type& alloc = {});
+        Node(Node&& other) noexcept;
+        Node(Node&& other, const allocator_type& alloc);
+
+        Node& operator=(const Node& other);
+        Node& operator=(Node&& other);
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return this->name.get_allocator(); }
+
         template<typename T = std::string>
         T as()
             const
         {
-            IF_T_IS_TYPE(std::string) {
-                return this->value;
-            }
-            IF_T_IS_TYPE(int) {
-                if (this->type != node::INTEGER) {
-                    throw exception::InvalidNodeType(this->name, "INT");
-                }
-                return std::stoi(value);
-            }
-            IF_T_IS_TYPE(double) {
-                if (this->type != node::DOUBLE && this->type != node::INTEGER) {
-                    throw exception::InvalidNodeType(this->name, "FLOAT");
-                }
-                return std::stod(value);
-            }
-            IF_T_IS_TYPE(bool) {
-                if (this->type != node::BOOLEAN) {
-                    throw exception::InvalidNodeType(this->name, "BOOLEAN");
-                }
-                return this->value == "true" || this->value == "1";
+            return node::convert<T>(this->name, this->value, this->type);
+        }
+
+        /**
+         * @brief   Converts the value of the Node to T, without throwing.
+         *
+         * @returns The converted value, or std::nullopt where as<T>() would
+         *          throw.
+         */
+        template<typename T = std::string>
+        [[nodiscard]] std::optional<T> tryAs()
+            const noexcept(!std::is_same_v<T, std::string>)
+        {
+            return node::tryConvert<T>(this->value, this->type);
+        }
+
+        /**
+         * @brief   Converts the values of all the children (typically list
+         *          items) to numbers, in one pass and without throwing.
+         *
+         * @param   out Receives the numbers, in order. Only the first
+         *              min(children.size(), out.size()) values are converted.
+         * @returns How many values were written and, if one of them is not a
+         *          number of type T, the index of the first such value.
+         */
+        template<typename T>
+        node::BulkResult copyTo(const std::span<T> out)
+            const noexcept
+        {
+            const Tree::Children& items = this->children.getNodes();
+
+            return node::convertAll(items.size(), [&items](const size_t i) -> std::string_view {
+                return items[i].value;
+            }, out);
+        }
+
+        /**
+         * @brief   Converts the values of all the children (typically list
+         *          items) to numbers, in one pass.
+         *
+         * @returns The numbers, in order
+         * @throws  exception::InvalidNodeType  If one of the values is not a
+         *                                      number of type T. The message
+         *                                      names the first such value.
+         */
+        template<typename T>
+        std::vector<T> asVector()
+            const
+        {
+            std::vector<T> result(this->children.size());
+            const node::BulkResult status = this->copyTo(std::span<T>(result));
+
+            if (!status.ok()) {
+                node::throwBulkError<T>(this->name, status);
             }
+            return result;
+        }
 
-            throw exception::UnknownNodeType(this->name);
+        /**
+         * @brief   Looks a direct child up by name and converts its value to
+         *          T, without throwing.
+         *
+         * Meant for probing optional keys.
+         *
+         * @param   key     The name of the child Node
+         * @returns The converted value, or std::nullopt if there is no such
+         *          child or if its value cannot be converted.
+         */
+        template<typename T = std::string>
+        [[nodiscard]] std::optional<T> tryGet(const std::string_view key)
+            const noexcept(!std::is_same_v<T, std::string>)
+        {
+            const auto child = this->children.find(key);
+
+            return child ? child->get().tryAs<T>() : std::nullopt;
         }
 
+        /**
+         * @brief   Looks a direct child up by name, without throwing.
+         *
+         * @param   key     The name of the child Node to look for
+         * @returns An optional reference to the found Node, or std::nullopt if
+         *          not found.
+         */
+        [[nodiscard]] std::optional<std::reference_wrapper<Node>>
+            find(const std::string_view key) { return this->children.find(key); }
+
+        /**
+         * @brief   Looks a direct child up by name, without throwing (const
+         *          version).
+         *
+         * @param   key     The name of the child Node to look for
+         * @returns An optional reference to the found Node, or std::nullopt if
+         *          not found.
+         */
+        [[nodiscard]] std::optional<std::reference_wrapper<const Node>>
+            find(const std::string_view key) const noexcept { return this->children.find(key); }
+
         /**
          * @brief   Prints the Node and its children recursively to the
          *          standard output.
@@ -193,7 +751,7 @@ namespace yml
          * @param   name    The name of the child Node to access
          * @returns A reference to the corresponding child Node
          */
-        Node& operator[](const std::string& name) { return this->children[name]; }
+        Node& operator[](const std::string_view name) { return this->children[name]; }
 
         /**
          * @brief   Accesses a child node by its name (const version).
@@ -204,7 +762,7 @@ namespace yml
          * @param   name    The name of the child Node to access
          * @returns A const reference to the corresponding child Node
          */
-        const Node& operator[](const std::string& name) const { return this->children[name]; }
+        const Node& operator[](const std::string_view name) const { return this->children[name]; }
 
         /**
          * @brief   Accesses a child node by its index.
@@ -227,9 +785,81 @@ namespace yml
          */
         const Node& operator[](const size_t index) const { return this->children[index]; }
 
+        /**
+         * @brief   Fingerprint of the node and its whole subtree (name, value,
+         *          type and children).
+         *
+         * Two subtrees with different fingerprints differ. Two subtrees with
+         * the same fingerprint are equal, barring a 64-bit collision.
+         * Computed on first request and cached, with the same thread-safety
+         * caveat as Tree::hash().
+         *
+         * The cache is dropped by setValue() and by the Tree API, not by
+         * writes to the public fields: after writing to name, value, isList
+         * or type directly, call invalidateHash(), or the fingerprints of the
+         * node and of the nodes above it stay stale.
+         */
+        [[nodiscard]] uint64_t hash() const noexcept;
+
+        /**
+         * @brief   Drops the cached fingerprint of the node and of the nodes
+         *          above it.
+         *
+         * Changes made through setValue() and the Tree API invalidate the
+         * fingerprints on their own. This must be called after writing to
+         * name, value, isList or type directly.
+         */
+        void invalidateHash() noexcept;
+
+        /**
+         * @brief   Replaces the value of the node, detecting its type again.
+         *
+         * Drops the cached fingerprints, unlike a write to value.
+         *
+         * @param   text    The new value
+         */
+        void setValue(std::string_view text);
+
+        /**
+         * @brief   Compares two nodes and their subtrees.
+         *
+         * The nodes themselves are compared field by field; their subtrees
+         * only by fingerprint, so the cost does not depend on their size.
+         */
+        [[nodiscard]] bool operator==(const Node& other) const noexcept
+        {
+            return this->hash() == other.hash()
+                && this->isList == other.isList
+                && this->type == other.type
+                && this->name == other.name
+                && this->value == other.value;
+        }
+
     private:
+        friend class Tree;
+
+        Tree* _container = nullptr;     /// Tree this node is stored in
+        mutable uint64_t _hash = 0;
+        mutable bool _hashed = false;
+
         void detectList();
         void detectType();
     };
 
 }
+
+/**
+ * Fingerprints as std::hash, so that nodes and trees can be used as keys of
+ * unordered containers.
+ */
+template<>
+struct std::hash<yml::Node>
+{
+    size_t operator()(const yml::Node& node) const noexcept { return node.hash(); }
+};
+
+template<>
+struct std::hash<yml::Tree>
+{
+    size_t operator()(const yml::Tree& tree) const noexcept { return tree.hash(); }
+};
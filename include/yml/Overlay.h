@@ -0,0 +1,210 @@
+#pragma once
+
+#include "yml/Yml.h"
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace yml
+{
+
+    /**
+     * @brief   Copy-on-write changes over a base document.
+     *
+     * An overlay stores only the nodes it sets or removes, by dotted path.
+     * Lookups that it does not cover fall through to the document below,
+     * which is shared, never copied. Overlays can be stacked, e.g. one per
+     * tenant over one per environment over a common base:
+     * @code
+     *  const auto base = std::make_shared<const yml::Yml>("base.yml");
+     *  const auto prod = std::make_shared<yml::Overlay>(base);
+     *
+     *  prod->set("server.replicas", "8");
+     *
+     *  yml::Overlay tenant(prod);
+     *
+     *  tenant.set("server.host", "acme.example.org");
+     *  tenant.remove("debug");
+     *  tenant.tryGet<int>("server.replicas"); // 8
+     * @endcode
+     *
+     * The documents below must not be modified while the overlay is in use.
+     */
+    class Overlay final
+    {
+    public:
+        /**
+         * @brief   Creates an empty overlay over a document.
+         *
+         * @param   base        The document below
+         * @param   resource    The memory resource of the overlay's own nodes.
+         *                      Must outlive the instance.
+         */
+        explicit Overlay(
+            std::shared_ptr<const Yml> base,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        );
+
+        /**
+         * @brief   Creates an empty overlay over another overlay.
+         *
+         * @param   lower       The overlay below
+         * @param   resource    The memory resource of the overlay's own nodes.
+         *                      Must outlive the instance.
+         */
+        explicit Overlay(
+            std::shared_ptr<const Overlay> lower,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        );
+
+        /**
+         * @brief   Sets the value of a node, replacing the node below if any.
+         *
+         * Missing parents are created as empty objects.
+         *
+         * @param   path    The dotted path of the node
+         * @param   value   Its new value
+         */
+        void set(std::string_view path, std::string_view value);
+
+        /**
+         * @brief   Replaces a whole subtree.
+         *
+         * @param   path    The dotted path of the node
+         * @param   node    The node to copy there. Its name is ignored: it is
+         *                  named after the last part of path.
+         */
+        void set(std::string_view path, const Node& node);
+
+        /**
+         * @brief   Hides a node, and all of its children, from the overlay.
+         *
+         * @param   path    The dotted path of the node
+         */
+        void remove(std::string_view path);
+
+        /**
+         * @brief   Retrieves a node through the overlay.
+         *
+         * The node and its children are as seen through the overlay: a node
+         * with changes below it is merged with them. Merged nodes are built
+         * on first request and kept until the next change to the overlay,
+         * which invalidates references to them.
+         *
+         * @param   search  The dotted path of the node
+         * @returns The node, from the overlay or from below, or std::nullopt
+         *          if there is none.
+         */
+        std::optional<std::reference_wrapper<const Node>>
+            getNode(std::string_view search) const;
+
+        /**
+         * @brief   Same as Yml::tryGet(), through the overlay.
+         */
+        template<typename T = std::string>
+        [[nodiscard]] std::optional<T> tryGet(const std::string_view search)
+            const
+        {
+            const auto node = this->getNode(search);
+
+            return node ? node->get().tryAs<T>() : std::nullopt;
+        }
+
+        /**
+         * @brief   Builds the document as seen through the overlay.
+         *
+         * Copies the whole document below, so that it only costs memory for
+         * the duration of the call.
+         *
+         * @returns The merged document, frozen
+         */
+        [[nodiscard]] FrozenYml flatten() const;
+
+        /**
+         * @brief   Writes the document as seen through the overlay to a tree.
+         *
+         * @param   tree    The tree to fill, replacing its content
+         */
+        void merge(Tree& tree) const;
+
+        /**
+         * @returns The number of paths the overlay itself sets or removes.
+         */
+        [[nodiscard]] size_t size() const { return this->_changes.size(); }
+
+    private:
+        /**
+         * @brief   A node set or removed at some path.
+         */
+        struct Change
+        {
+            Node node;
+            bool removed;
+        };
+
+        std::shared_ptr<const Yml> _base;
+        std::shared_ptr<const Overlay> _lower;
+
+        /// No path is below another one: changes below a path already set are
+        /// made in its node.
+        std::pmr::unordered_map<std::pmr::string, Change, StringHash, std::equal_to<>> _changes;
+
+        /// Number of changed paths below each path that has some
+        std::pmr::unordered_map<std::pmr::string, size_t, StringHash, std::equal_to<>> _below;
+
+        /**
+         * @brief   Nodes with changes below them, merged with those, by path.
+         *
+         * Built on demand, so copies of the overlay start without them.
+         */
+        struct Merged
+        {
+            std::pmr::unordered_map<std::pmr::string, Node, StringHash, std::equal_to<>> nodes;
+            std::mutex mutex;
+
+            explicit Merged(std::pmr::memory_resource* resource) : nodes(resource) {}
+            Merged(const Merged& other) : nodes(other.nodes.get_allocator()) {}
+            Merged& operator=(const Merged&) { this->nodes.clear(); return *this; }
+        };
+
+        mutable Merged _merged;
+
+        /**
+         * @brief   Finds the change covering a path.
+         *
+         * @param   path    The dotted path to look for
+         * @param   rest    Set to what follows the path of the change
+         * @returns The change, or nullptr if path goes through the document
+         *          below.
+         */
+        const Change* cover(std::string_view path, std::string_view& rest) const noexcept;
+
+        /**
+         * @brief   Stores a node, or removes the one at path if node is null.
+         */
+        void change(std::string_view path, const Node* node);
+
+        /**
+         * @brief   Adds delta to the count of changed paths below each
+         *          ancestor of path.
+         */
+        void count(std::string_view path, int delta);
+
+        /**
+         * @brief   Builds, or finds, the node at a path with changes below
+         *          it.
+         */
+        std::optional<std::reference_wrapper<const Node>>
+            mergedNode(std::string_view search) const;
+
+        std::optional<std::reference_wrapper<const Node>>
+            lowerNode(std::string_view search) const;
+    };
+
+}
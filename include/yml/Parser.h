@@ -1,7 +1,12 @@
 #pragma once
 
+#include "yml/Schema.h"
 #include "yml/Yml.h"
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace yml
@@ -12,6 +17,14 @@ namespace yml
      *
      * This class processes raw YML strings, interprets their structure,
      * and organizes the data into a hierarchical Tree of Node objects.
+     *
+     * Anchors (`key: &name`) and aliases (`other: *name`) are supported. The
+     * children of an anchored object are shared with every alias to it,
+     * rather than copied: see Tree::share(). An alias to an unknown anchor is
+     * kept as a plain string.
+     *
+     * When given a Schema, nodes are checked as they are placed, so that
+     * validating costs no second walk of the tree.
      */
     class Parser final
     {
@@ -27,15 +40,66 @@ namespace yml
         explicit Parser
         (
             Yml& yml,
-            const std::string& rawContent,
+            const std::string_view rawContent,
             Tree& tree,
             const uint8_t nestingLevel
         )
-            : _ymlInstance(yml), _tree(tree), _nestingLevel(nestingLevel)
+            : Parser(yml, tree, nestingLevel)
         {
             parse(rawContent);
         }
 
+        /**
+         * @brief   Constructs a Parser that is given the content piece by
+         *          piece, through feed() and finish().
+         *
+         * @param   yml             Reference to the associated Yml instance
+         * @param   tree            Reference to the tree structure to populate
+         * @param   nestingLevel    The number of spaces used to represent one
+         *                          level of nesting
+         * @param   schema          The rules to check the nodes against, if
+         *                          any. Must outlive the parser.
+         * @param   violations      Receives the nodes breaking the rules. If
+         *                          null, the first one is thrown instead.
+         */
+        Parser
+        (
+            Yml& yml,
+            Tree& tree,
+            const uint8_t nestingLevel,
+            const Schema* schema = nullptr,
+            std::vector<schema::Violation>* violations = nullptr
+        )
+            : _ymlInstance(yml),
+              _tree(tree),
+              _parents(tree.get_allocator()),
+              _nestingLevel(nestingLevel),
+              _schema(schema),
+              _violations(violations),
+              _entries(tree.get_allocator())
+        {}
+
+        /**
+         * @brief   Parses every complete line of a piece of content.
+         *
+         * The content does not need to outlive the call.
+         *
+         * @param   content The content following what was consumed so far
+         * @returns The number of bytes consumed, up to and including the last
+         *          newline. The rest must be given again, with what follows,
+         *          to the next call.
+         */
+        size_t feed(std::string_view content);
+
+        /**
+         * @brief   Parses the last, unterminated line and completes the tree.
+         *
+         * @param   rest    What feed() has not consumed
+         * @throws  exception::SchemaViolation  If a node breaks the schema
+         *                                      and violations are thrown
+         */
+        void finish(std::string_view rest);
+
         /**
          * @brief   Splits a string by a delimiter character.
          *
@@ -51,12 +115,70 @@ namespace yml
             char delim
         );
 
+        /**
+         * @brief   Pops the next token of a string, without allocating.
+         *
+         * Yields the same tokens as split(), one call at a time:
+         * @code
+         *  while (Parser::nextToken(rest, '.', part)) { ... }
+         * @endcode
+         *
+         * @param   str     The remaining string. Updated to what follows the
+         *                  token.
+         * @param   delim   The delimiter character
+         * @param   token   Set to the trimmed token
+         * @returns False once every token has been consumed.
+         */
+        static bool nextToken(
+            std::string_view& str,
+            char delim,
+            std::string_view& token
+        );
+
     private:
+        /**
+         * @brief   What an alias resolves to.
+         */
+        struct Anchor
+        {
+            std::shared_ptr<const Tree> tree;   /// Null for scalars
+            std::string value;
+        };
+
+        /**
+         * @brief   An anchored object whose children are still being parsed.
+         */
+        struct PendingAnchor
+        {
+            size_t level;                       /// Position in _parents
+            Node* node;
+            std::string name;
+        };
+
         Yml& _ymlInstance;
         Tree& _tree;
-        std::string _currentPath;
+        std::pmr::vector<Node*> _parents;   /// Objects open at each depth
         uint8_t _nestingLevel;
 
+        std::unordered_map<std::string, Anchor, StringHash, std::equal_to<>> _anchors;
+        std::vector<PendingAnchor> _pending;
+
+        /**
+         * @brief   Schema entry of an open object.
+         */
+        struct Frame
+        {
+            uint32_t entry;                     /// Schema::NONE if unchecked
+            size_t line;
+            size_t required = 0;                /// Required children placed
+        };
+
+        const Schema* _schema;
+        std::vector<schema::Violation>* _violations;
+        std::pmr::vector<Frame> _entries;   /// Parallel to _parents
+        size_t _line = 0;                   /// Line being parsed, from 1
+        size_t _required = 0;               /// Required top-level keys placed
+
         /**
          * @brief   Parses the entire raw YML content.
          *
@@ -64,7 +186,7 @@ namespace yml
          *
          * @param   rawContent  The raw YML content to parse
          */
-        void parse(const std::string& rawContent);
+        void parse(std::string_view rawContent);
 
         /**
          * @brief   Parses a single line of YML content.
@@ -73,16 +195,101 @@ namespace yml
          *
          * @param   needle  The line of text to parse
          */
-        void parseLine(const std::string& needle);
+        void parseLine(std::string_view needle);
 
         /**
          * @brief   Places a Node into the tree based on its indentation level.
          *
          * @param   needle  The original line string
-         * @param   node    The Node to place
+         * @param   node    The Node to place. Moved into the tree.
          * @param   spaces  The number of leading spaces (indentation level)
+         * @returns The node as stored in the tree.
          */
-        void placeNode(const std::string& needle, Node& node, size_t spaces);
+        Node& placeNode(std::string_view needle, Node& node, size_t spaces);
+
+        /**
+         * @brief   Defines an anchor on a node that was just placed.
+         *
+         * Scalars are defined at once. Objects are once all their children
+         * are parsed, see closeAnchors().
+         *
+         * @param   name    The name of the anchor, without the `&`
+         * @param   node    The anchored node
+         */
+        void defineAnchor(std::string_view name, Node& node);
+
+        /**
+         * @brief   Defines the anchors of the objects being closed, sharing
+         *          their children.
+         *
+         * @param   level   The number of open objects left open
+         */
+        void closeAnchors(size_t level);
+
+        /**
+         * @brief   Checks the objects being closed against the schema,
+         *          children included.
+         *
+         * @param   level   The number of open objects left open
+         */
+        void closeEntries(size_t level);
+
+        /**
+         * @brief   Checks a node against its schema entry.
+         *
+         * @param   entry   The entry of the node
+         * @param   node    The node, with all its children
+         * @param   level   The number of open objects above node
+         * @param   line    The line of node
+         * @param   seen    The number of required children of node placed.
+         *                  They are only looked for if some are missing.
+         */
+        void check(uint32_t entry, const Node& node, size_t level, size_t line, size_t seen);
+
+        /**
+         * @brief   Reports the required children missing from a tree.
+         *
+         * @param   entry       The schema entry of the tree
+         * @param   children    The tree
+         * @param   level       The number of open objects above its node
+         * @param   name        The name of its node, empty for the root
+         * @param   line        The line of its node
+         * @param   seen        The number of required children placed
+         */
+        void checkRequired(uint32_t entry, const Tree& children, size_t level, std::string_view name, size_t line, size_t seen);
+
+        /**
+         * @brief   Checks the descendants of an alias, which are not parsed
+         *          but shared, against the schema.
+         *
+         * Violations are reported at the line of the alias.
+         *
+         * @param   entry       The schema entry of the alias
+         * @param   children    Its children
+         * @param   level       The number of open objects above the alias
+         * @param   name        The path of the alias from there
+         */
+        void checkShared(uint32_t entry, const Tree& children, size_t level, std::string_view name);
+
+        /**
+         * @brief   Reports that a node breaks the schema.
+         *
+         * @param   level   The number of open objects above the node
+         * @param   name    The name of the node
+         * @param   line    The line of the node
+         * @param   reason  What is wrong with it
+         * @throws  exception::SchemaViolation  If violations are thrown
+         */
+        void report(size_t level, std::string_view name, size_t line, std::string reason);
+
+        /**
+         * @brief   Splits a leading `&anchor` off a value.
+         *
+         * @param   value   The value. Set to what follows the anchor.
+         * @returns The name of the anchor, or an empty string if there is
+         *          none.
+         */
+        static std::string_view takeAnchor(std::string_view& value);
 
 
         /**
@@ -91,7 +298,7 @@ namespace yml
          * @param   needle  The line to check
          * @returns True if the line should be skipped, false otherwise.
          */
-        static bool shouldSkipLine(const std::string& needle);
+        static bool shouldSkipLine(std::string_view needle);
 
         /**
          * @brief   Counts the number of leading spaces in a string.
@@ -101,18 +308,7 @@ namespace yml
          * @param   str The string to analyze
          * @returns The number of leading spaces
          */
-        static size_t countLeadingSpaces(const std::string& str);
-
-        /**
-         * @brief   Calculates the substring size for a given path depth.
-         *
-         * Helps in managing nested paths when inserting nodes.
-         *
-         * @param   path    The full path string
-         * @param   n       The desired depth
-         * @returns The size (number of characters) up to depth n
-         */
-        static size_t getPathSize(const std::string& path, size_t n);
+        static size_t countLeadingSpaces(std::string_view str);
 
         /**
          * @brief   Determines if a line represents a new object (key with
@@ -122,7 +318,7 @@ namespace yml
          * @param   needle  The line to inspect.
          * @returns True if it represents an object, false otherwise.
          */
-        static bool isObject(const std::string& name, const std::string& needle);
+        static bool isObject(std::string_view name, std::string_view needle);
     };
 
 }
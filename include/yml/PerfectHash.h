@@ -0,0 +1,95 @@
+#pragma once
+
+#include "yml/Hash.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace yml
+{
+
+    /**
+     * @brief   Minimal perfect hash function over a fixed set of keys.
+     *
+     * Built with the "hash and displace" scheme: keys are first spread into
+     * buckets, then every bucket gets a seed that sends all of its keys to
+     * distinct free slots. Looking a key up costs one string hash and one
+     * probe, with no collision chain.
+     *
+     * Slots are in [0, size()). A key that was not part of the build set
+     * still maps to some slot, so callers must compare the key stored in that
+     * slot before using it.
+     */
+    class PerfectHash final
+    {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        PerfectHash() = default;
+
+        explicit PerfectHash(const allocator_type& alloc) : _seeds(alloc) {}
+
+        /**
+         * @brief   Builds the function for the given keys.
+         *
+         * Keys must be unique.
+         *
+         * @param   keys    The keys to hash
+         * @returns True on success. On failure, the function is left empty.
+         */
+        bool build(const std::vector<std::string_view>& keys);
+
+        /**
+         * @brief   Computes the slot of a key.
+         *
+         * Must not be called on an empty function.
+         *
+         * @param   key The key to look up
+         * @returns The slot the key maps to
+         */
+        [[nodiscard]] size_t slot(const std::string_view key) const noexcept
+        {
+            return slot(key, this->_seeds.data(), this->_seeds.size());
+        }
+
+        /**
+         * @brief   Computes the slot of a key from a raw seed table.
+         *
+         * Lets the seeds be stored elsewhere (e.g. in a frozen document)
+         * once the function is built.
+         *
+         * @param   key     The key to look up
+         * @param   seeds   The seeds of the function, see seeds()
+         * @param   size    The number of seeds. Must not be 0.
+         * @returns The slot the key maps to
+         */
+        [[nodiscard]] static constexpr size_t slot(
+            const std::string_view key,
+            const uint32_t* seeds,
+            const size_t size
+        ) noexcept
+        {
+            const uint64_t h = hash::string(key);
+
+            return hash::mix(h, seeds[hash::mix(h) % size]) % size;
+        }
+
+        [[nodiscard]] const std::pmr::vector<uint32_t>& seeds() const noexcept { return this->_seeds; }
+
+        /**
+         * @returns The number of slots, i.e. the number of keys it was built
+         *          with.
+         */
+        [[nodiscard]] size_t size() const noexcept { return this->_seeds.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return this->_seeds.empty(); }
+
+        void clear() noexcept;
+
+    private:
+        std::pmr::vector<uint32_t> _seeds;  /// One per bucket, as many as keys
+    };
+
+}
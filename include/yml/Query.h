@@ -0,0 +1,107 @@
+#pragma once
+
+#include "yml/Exceptions/InvalidQuery.h"
+#include "yml/Yml.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yml
+{
+
+    /**
+     * @brief   Compiled path pattern, matched against a whole tree at once.
+     *
+     * Patterns extend the dotted paths of Yml::getNode() with:
+     *  - `*`, which matches every child;
+     *  - `**`, which matches any number of levels, including none;
+     *  - `[i]`, which matches the i-th child, in insertion order, and can
+     *    follow any segment (`[*]` is the same as `.*`).
+     *
+     * A name matches every child of that name, so that `backends.name`
+     * yields the `- name` entry of every item of the backends list.
+     *
+     * @code
+     *  const yml::Query ports("services.*.port");
+     *  std::vector<const yml::Node*> matches;
+     *
+     *  ports.evaluate(yml, matches);
+     * @endcode
+     */
+    class Query final
+    {
+    public:
+        /**
+         * @brief   Compiles a pattern.
+         *
+         * @param   pattern The pattern, e.g. "services.*.ports[0]"
+         * @throws  exception::InvalidQuery If the pattern is malformed
+         */
+        explicit Query(std::string_view pattern);
+
+        /**
+         * @brief   Finds every node of a tree matching the pattern.
+         *
+         * The tree is traversed once, and only along the branches the pattern
+         * can match. Nothing is allocated besides the growth of matches, so
+         * reusing the same vector across calls avoids allocating at all.
+         * A pattern with several `**` may report a node more than once.
+         *
+         * @param   tree    The tree to search, as the root of the pattern
+         * @param   matches Receives the matching nodes, in traversal order.
+         *                  Appended to, not cleared.
+         * @returns The number of nodes appended to matches.
+         */
+        size_t evaluate(const Tree& tree, std::vector<const Node*>& matches) const;
+
+        size_t evaluate(const Yml& yml, std::vector<const Node*>& matches) const
+        {
+            return this->evaluate(yml.getTree(), matches);
+        }
+
+        /**
+         * @brief   Same as evaluate(), with node's children as the root of
+         *          the pattern.
+         */
+        size_t evaluate(const Node& node, std::vector<const Node*>& matches) const
+        {
+            return this->evaluate(node.children, matches);
+        }
+
+        [[nodiscard]] const std::string& pattern() const { return this->_pattern; }
+
+    private:
+        struct Segment
+        {
+            enum Kind
+            {
+                NAME,       // A child of that name
+                ANY,        // `*`: every child
+                DESCEND,    // `**`: any number of levels
+                INDEX       // `[i]`: the i-th child
+            };
+
+            Kind kind;
+            std::string name;
+            size_t index = 0;
+        };
+
+        std::string _pattern;
+        std::vector<Segment> _segments;
+
+        /**
+         * @brief   Compiles one dot-separated part of the pattern.
+         */
+        void compile(std::string_view part);
+
+        void match(const Tree& tree, size_t segment, std::vector<const Node*>& matches) const;
+
+        /**
+         * @brief   Goes on with the next segment under a child that matched
+         *          the current one.
+         */
+        void matchNext(const Node& node, size_t segment, std::vector<const Node*>& matches) const;
+    };
+
+}
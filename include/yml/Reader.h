@@ -0,0 +1,130 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace yml::io
+{
+
+    /**
+     * @brief   How a FileReader reads from the disk.
+     */
+    enum class Backend
+    {
+        BLOCKING,   // One read at a time, with the C standard library
+        IO_URING    // Several reads in flight through io_uring (Linux only)
+    };
+
+    /// Size of the blocks read by a FileReader.
+    inline constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    /**
+     * @brief   Checks whether a backend can be used on this system.
+     *
+     * io_uring may be missing from the kernel, or forbidden by a sandbox.
+     * The first call probes for it; later ones return the cached answer.
+     */
+    bool isAvailable(Backend backend) noexcept;
+
+    /**
+     * @brief   Reads a whole file into a string on a background thread.
+     *
+     * The string is sized once, up front, and filled in blocks. The bytes
+     * before wait() returns are final and can be read while the rest of the
+     * file is still being read, which lets a parser run alongside the disk.
+     *
+     * Files whose size is not known in advance (pipes, special files) are
+     * read at once by the constructor instead.
+     */
+    class FileReader final
+    {
+    public:
+        /**
+         * @brief   Opens a file and starts reading it.
+         *
+         * @param   filepath    The path to the file to read
+         * @param   content     The string to fill, which keeps its allocator.
+         *                      Must not be touched until wait() reports the
+         *                      end of the file.
+         * @param   backend     How to read. Falls back to Backend::BLOCKING
+         *                      if unavailable.
+         * @param   blockSize   Size of each read
+         * @param   progress    If set, called on the reading thread with the
+         *                      number of bytes ready, each time more are.
+         *                      Not called for files read at once.
+         * @throws  exception::CouldNotOpenFile If file could not be opened for
+         *                                      some reason
+         */
+        FileReader(
+            const std::string& filepath,
+            std::pmr::string& content,
+            Backend backend = Backend::BLOCKING,
+            size_t blockSize = DEFAULT_BLOCK_SIZE,
+            std::function<void(size_t)> progress = {}
+        );
+
+        /**
+         * @brief   Stops reading, waiting for the reads in flight.
+         */
+        ~FileReader();
+
+        FileReader(const FileReader&) = delete;
+        FileReader& operator=(const FileReader&) = delete;
+
+        /**
+         * @brief   Waits until more than known bytes have been read, or until
+         *          the end of the file.
+         *
+         * @param   known   The number of bytes the caller already knows of
+         * @returns The number of bytes read so far, from the start of the
+         *          file. Equal to known once the whole file has been read, at
+         *          which point the string is trimmed to that size.
+         * @throws  std::system_error   If reading failed
+         */
+        size_t wait(size_t known);
+
+        /**
+         * @returns The backend actually in use. A Backend::IO_URING reader
+         *          that fails to set its ring up still falls back to
+         *          blocking reads on its thread.
+         */
+        [[nodiscard]] Backend backend() const { return this->_backend; }
+
+    private:
+        std::pmr::string& _content;
+        char* _data;                    /// Start of the content, fixed while reading
+        size_t _size;                   /// Size of the file when it was opened
+        size_t _blockSize;
+        Backend _backend;
+        std::function<void(size_t)> _onProgress;
+
+        std::mutex _mutex;
+        std::condition_variable _progress;
+        size_t _ready = 0;              /// Bytes read, all from the start
+        bool _done = false;             /// Set once the reading thread is over
+        bool _cancel = false;           /// Asks the reading thread to stop
+        std::exception_ptr _error;
+
+        std::thread _thread;
+
+        /**
+         * @brief   Reports that the first ready bytes have been read.
+         *
+         * @returns False if reading should stop.
+         */
+        bool publish(size_t ready);
+
+        void finish(std::exception_ptr error);
+
+        void readBlocking(std::FILE* file);
+        void readUring(int fd);
+    };
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "yml/Exceptions/InvalidSchema.h"
+#include "yml/Node.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace yml
+{
+
+    class Yml;
+
+    namespace schema
+    {
+
+        /**
+         * @brief   What a node must look like.
+         */
+        struct Rule
+        {
+            /// Expected type. UNKNOWN accepts anything, STRING any scalar,
+            /// DOUBLE any number, OBJECT any mapping and LIST any list.
+            node::Type type = node::UNKNOWN;
+            bool required = false;
+            std::optional<double> min;  /// Lowest value allowed, for numbers
+            std::optional<double> max;  /// Highest value allowed, for numbers
+        };
+
+        /**
+         * @brief   A node that does not follow its rule.
+         */
+        struct Violation
+        {
+            std::string path;   /// Dotted path of the node
+            size_t line;        /// Line of the node, or of the mapping a
+                                /// required key is missing from. 0 for
+                                /// keys missing at the top level.
+            std::string reason;
+        };
+
+    }
+
+    /**
+     * @brief   Rules that a document must follow, checked while it is
+     *          parsed (see Yml::loadFromRawContent()).
+     *
+     * Rules are attached to dotted paths, where `*` matches any name,
+     * including list items, and cannot be required. Nodes without a rule are
+     * not checked.
+     *
+     * @code
+     *  yml::Schema schema;
+     *
+     *  schema.add("server.port", { yml::node::INTEGER, true, 1, 65535 });
+     *  schema.add("services.*.image", { yml::node::STRING, true });
+     * @endcode
+     */
+    class Schema final
+    {
+    public:
+        /// Returned by child() when a name has no rule.
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        /// The (unnamed) root of the document, parent of the top-level keys.
+        static constexpr uint32_t ROOT = 0;
+
+        Schema();
+
+        /**
+         * @brief   Loads a schema written as YML.
+         *
+         * Each key is the path of a node, and its value the rule of that
+         * node, as space-separated words: a type (`string`, `integer`,
+         * `number`, `boolean`, `object`, `list` or `any`), `required`,
+         * `min=<number>` and `max=<number>`. Mappings nest paths:
+         * @code
+         *  server:
+         *    port: integer required min=1 max=65535
+         *  server.host: string required
+         * @endcode
+         *
+         * @param   definition  The parsed schema
+         * @throws  exception::InvalidSchema    If a rule is malformed
+         */
+        explicit Schema(const Yml& definition);
+
+        /**
+         * @brief   Sets the rule of a path, replacing any previous one.
+         *
+         * @param   path    The dotted path of the node
+         * @param   rule    Its rule
+         * @returns This schema, for chaining.
+         * @throws  exception::InvalidSchema    If path is empty
+         */
+        Schema& add(std::string_view path, const schema::Rule& rule);
+
+        /**
+         * @brief   Parses the text of a rule, as written in a YML schema.
+         *
+         * @param   path    The path the rule is for, used in error messages
+         * @param   text    The rule, e.g. "integer required min=1"
+         * @returns The rule
+         * @throws  exception::InvalidSchema    If the rule is malformed
+         */
+        static schema::Rule parseRule(std::string_view path, std::string_view text);
+
+        /**
+         * @brief   Finds the entry of a child.
+         *
+         * @param   parent  The entry of the parent, ROOT for top-level keys
+         * @param   name    The name of the child
+         * @returns The entry of the child, or NONE if it has no rule.
+         */
+        [[nodiscard]] uint32_t child(uint32_t parent, std::string_view name) const noexcept;
+
+        [[nodiscard]] const schema::Rule& rule(const uint32_t entry) const { return this->_entries[entry].rule; }
+
+        /**
+         * @returns The names of the required children of an entry.
+         */
+        [[nodiscard]] std::span<const std::string> required(const uint32_t entry) const { return this->_entries[entry].required; }
+
+        /**
+         * @brief   Checks a node against the rule of its entry.
+         *
+         * @param   entry   The entry of the node
+         * @param   node    The node, whose children are all known
+         * @returns Why the node does not follow the rule, or an empty string
+         *          if it does.
+         */
+        [[nodiscard]] std::string check(uint32_t entry, const Node& node) const;
+
+    private:
+        struct Entry
+        {
+            schema::Rule rule;
+            std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> children;
+            uint32_t any = NONE;                /// Entry of `*`
+            std::vector<std::string> required;  /// Names of required children
+        };
+
+        std::vector<Entry> _entries;
+
+        void load(const Tree& tree, const std::string& prefix);
+    };
+
+}
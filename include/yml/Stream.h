@@ -0,0 +1,145 @@
+#pragma once
+
+#include "yml/Yml.h"
+
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yml
+{
+
+    /**
+     * @brief   A stream of YML documents, separated by `---` and ended by
+     *          `...` lines.
+     *
+     * The content is scanned once for document boundaries, which gives an
+     * index of where each document lies. Documents are only parsed when
+     * asked for, either one at a time or all of them in turn.
+     *
+     * @code
+     *  const yml::Stream logs("events.yml");
+     *
+     *  logs.forEach([](const size_t i, const yml::Yml& event) { ... });
+     * @endcode
+     */
+    class Stream final
+    {
+    public:
+        /**
+         * @brief   Where a document lies in the content of the stream.
+         */
+        struct Document
+        {
+            size_t offset;
+            size_t size;
+        };
+
+        /**
+         * @brief   Reads a stream and indexes its documents.
+         *
+         * Files are indexed while they are being read.
+         *
+         * @param   filepath        The path to the file to read
+         * @param   isRawContent    If filepath param is the content itself
+         * @param   nestingLevel    The number of spaces used to represent one
+         *                          level of nesting. Defaults to
+         *                          YML_NESTING_SPACES.
+         * @param   resource        The memory resource to allocate the
+         *                          content and the documents from. Must
+         *                          outlive the instance and the documents.
+         * @throws  exception::CouldNotOpenFile If file could not be opened for
+         *                                      some reason
+         * @throws  std::system_error           If reading failed
+         */
+        explicit Stream(
+            std::string filepath,
+            bool isRawContent = false,
+            uint8_t nestingLevel = YML_NESTING_SPACES,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        );
+
+        /**
+         * @returns The number of documents in the stream.
+         */
+        [[nodiscard]] size_t size() const { return this->_documents.size(); }
+
+        [[nodiscard]] bool empty() const { return this->_documents.empty(); }
+
+        [[nodiscard]] const std::vector<Document>& getDocuments() const { return this->_documents; }
+
+        /**
+         * @returns The unparsed content of the index-th document, without its
+         *          markers.
+         * @throws  std::out_of_range   If index is out of range
+         */
+        [[nodiscard]] std::string_view raw(size_t index) const;
+
+        /**
+         * @brief   Parses a single document.
+         *
+         * @param   index   The position of the document in the stream
+         * @returns The document, independent from the stream.
+         * @throws  std::out_of_range   If index is out of range
+         */
+        [[nodiscard]] Yml load(size_t index) const;
+
+        /**
+         * @brief   Parses every document in turn, keeping only one in memory
+         *          at a time.
+         *
+         * The same Yml instance is reloaded for every document: references
+         * to its nodes do not outlive the call of fn they were taken in.
+         *
+         * @param   fn  Called with the position of each document and the
+         *              document, in stream order
+         */
+        void forEach(const std::function<void(size_t, const Yml&)>& fn) const;
+
+        /**
+         * @brief   Parses every document on a pool of worker threads.
+         *
+         * Each worker parses the documents it is handed, see parallelFor().
+         * The memory resource of the stream is then used from several threads
+         * at once, so it must be thread-safe.
+         *
+         * @param   fn      Called on the worker that parsed the document, in
+         *                  no particular order
+         * @param   threads Maximum number of threads to use. 0 means
+         *                  std::thread::hardware_concurrency().
+         * @throws  Anything thrown while parsing or by fn. The other documents
+         *          are still processed; the first exception is rethrown
+         *          once they all have been.
+         */
+        void parallelForEach(
+            const std::function<void(size_t, const Yml&)>& fn,
+            size_t threads = 0
+        ) const;
+
+    private:
+        std::pmr::string _content;
+        std::vector<Document> _documents;
+        uint8_t _nestingLevel;
+
+        size_t _scanned = 0;        /// Bytes of content indexed so far
+        size_t _start = 0;          /// Start of the current document
+        bool _open = false;         /// Whether the current document has begun
+
+        /**
+         * @brief   Indexes the lines of some content not indexed yet.
+         *
+         * @param   content The content read so far
+         * @param   last    Whether content is complete, in which case its
+         *                  last, unterminated line is indexed too
+         */
+        void scan(std::string_view content, bool last);
+
+        /**
+         * @brief   Ends the current document, if any, at end.
+         */
+        void close(size_t end);
+    };
+
+}
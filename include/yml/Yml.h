@@ -3,10 +3,16 @@
 #define MAX_STRING_LENGTH   1024
 #define YML_NESTING_SPACES  2
 
+#include "yml/Frozen.h"
 #include "yml/Node.h"
+#include "yml/Reader.h"
+#include "yml/Schema.h"
 
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace yml
 {
@@ -17,6 +23,12 @@ namespace yml
      * The Yml class provides functionality to load, parse, and search
      * for nodes within a YML-style structured file. It internally builds
      * a tree structure from the file's contents.
+     *
+     * The raw content and the whole tree are allocated from a single memory
+     * resource, the default one unless stated otherwise. With a
+     * std::pmr::monotonic_buffer_resource, loading barely allocates and all
+     * the memory is given back at once by releasing the resource, after the
+     * Yml instance is destroyed.
      */
     class Yml final
     {
@@ -30,6 +42,8 @@ namespace yml
          * @param   nestingLevel    The number of spaces used to represent one
          *                          level of nesting. Defaults to
          *                          YML_NESTING_SPACES.
+         * @param   resource        The memory resource to allocate the
+         *                          document from. Must outlive the instance.
          * @throws  exception::CouldNotOpenFile If file could not be opened for
          *                                      some reason
          * @throws  exception::IException       Parsing error
@@ -37,30 +51,151 @@ namespace yml
         explicit Yml(
             std::string filepath,
             bool isRawContent = false,
-            uint8_t nestingLevel = YML_NESTING_SPACES
+            uint8_t nestingLevel = YML_NESTING_SPACES,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
         );
 
         Yml() = default;
 
+        /**
+         * @brief   Constructs an empty Yml instance that allocates from a
+         *          given memory resource.
+         *
+         * @param   resource    The memory resource to allocate the document
+         *                      from. Must outlive the instance.
+         */
+        explicit Yml(std::pmr::memory_resource* resource);
+
         void loadFromFilepath(
             const std::string& filepath,
             uint8_t nestingLevel = YML_NESTING_SPACES
         );
 
+        /**
+         * @brief   Loads a file, parsing it while it is being read.
+         *
+         * The file is read in large blocks on a background thread, and each
+         * block is parsed as soon as it has been read, so that the load takes
+         * about as long as the slower of reading and parsing rather than both.
+         *
+         * @param   filepath        The path to the file to parse
+         * @param   nestingLevel    The number of spaces used to represent one
+         *                          level of nesting
+         * @param   backend         How to read the file. Falls back to
+         *                          io::Backend::BLOCKING if unavailable.
+         * @throws  exception::CouldNotOpenFile If file could not be opened for
+         *                                      some reason
+         * @throws  std::system_error           If reading failed
+         */
+        void loadFromFilepath(
+            const std::string& filepath,
+            uint8_t nestingLevel,
+            io::Backend backend
+        );
+
         void loadFromRawContent(
-            const std::string &rawContent,
+            std::string_view rawContent,
+            uint8_t nestingLevel = YML_NESTING_SPACES
+        );
+
+        /**
+         * @brief   Loads content, checking it against a schema as it is
+         *          parsed.
+         *
+         * @param   rawContent      The content to parse
+         * @param   schema          The rules the content must follow
+         * @param   failFast        Whether to stop at the first violation
+         * @param   nestingLevel    The number of spaces used to represent one
+         *                          level of nesting. Defaults to
+         *                          YML_NESTING_SPACES.
+         * @returns Every violation, in the order they were found. Empty if
+         *          the content follows the schema.
+         * @throws  exception::SchemaViolation  On the first violation, if
+         *                                      failFast is set. The document
+         *                                      is then only partly loaded.
+         */
+        std::vector<schema::Violation> loadFromRawContent(
+            std::string_view rawContent,
+            const Schema& schema,
+            bool failFast = false,
+            uint8_t nestingLevel = YML_NESTING_SPACES
+        );
+
+        /**
+         * @brief   Loads a file, checking it against a schema as it is
+         *          parsed. See loadFromRawContent(std::string_view, const
+         *          Schema&, bool, uint8_t).
+         *
+         * @throws  exception::CouldNotOpenFile If file could not be opened for
+         *                                      some reason
+         */
+        std::vector<schema::Violation> loadFromFilepath(
+            const std::string& filepath,
+            const Schema& schema,
+            bool failFast = false,
             uint8_t nestingLevel = YML_NESTING_SPACES
         );
 
+        [[nodiscard]] std::pmr::memory_resource* getResource() const { return this->_tree.get_allocator().resource(); }
+
         /**
          * @brief   Retrieves a node from the parsed tree by its search key.
          *
+         * The node may be modified: the aliases on the way to it are
+         * detached (see Tree::detach()). Use the const version to read.
+         *
          * @param   search  The key or identifier to search for within the tree
          * @returns An optional reference to the found Node, or std::nullopt if
          *          not found.
          */
         std::optional<std::reference_wrapper<Node>>
-            getNode(const std::string& search);
+            getNode(std::string_view search);
+
+        /**
+         * @brief   Retrieves a node from the parsed tree by its search key
+         *          (const version).
+         *
+         * @param   search  The key or identifier to search for within the tree
+         * @returns An optional reference to the found Node, or std::nullopt if
+         *          not found.
+         */
+        std::optional<std::reference_wrapper<const Node>>
+            getNode(std::string_view search) const noexcept;
+
+        /**
+         * @brief   Retrieves a node by its search key and converts its value
+         *          to T, without throwing.
+         *
+         * @param   search  The key or identifier to search for within the tree
+         * @returns The converted value, or std::nullopt if the node does not
+         *          exist or if its value cannot be converted.
+         */
+        template<typename T = std::string>
+        [[nodiscard]] std::optional<T> tryGet(const std::string_view search)
+            const noexcept(!std::is_same_v<T, std::string>)
+        {
+            const auto node = this->getNode(search);
+
+            return node ? node->get().tryAs<T>() : std::nullopt;
+        }
+
+        /**
+         * @brief   Marks the whole document as read-only.
+         *
+         * Every mapping gets a minimal perfect hash, so that lookups by name
+         * take a single probe. Loading new content unseals the document.
+         */
+        void seal() { this->_tree.seal(); }
+
+        /**
+         * @brief   Builds an immutable, compact copy of the document.
+         *
+         * The copy does not depend on this instance, which can then be
+         * discarded.
+         *
+         * @returns The frozen document
+         */
+        [[nodiscard]] FrozenYml freeze() const { return FrozenYml(this->_tree); }
 
         /**
          * @brief   Dumps the entire parsed tree structure to the standard
@@ -77,7 +212,7 @@ namespace yml
          * @param   name    The name of the node to access
          * @returns A reference to the corresponding Node
          */
-        Node& operator[](const std::string& name) { return this->_tree[name]; }
+        Node& operator[](const std::string_view name) { return this->_tree[name]; }
 
         /**
          * @brief   Provides read-only access to the root-level nodes by name.
@@ -88,24 +223,31 @@ namespace yml
          * @param   name    The name of the node to access
          * @returns A const reference to the corresponding Node
          */
-        const Node& operator[](const std::string& name) const { return this->_tree[name]; }
+        const Node& operator[](const std::string_view name) const { return this->_tree[name]; }
 
-        [[nodiscard]] std::string getRawContent() const { return this->_rawContent; }
+        [[nodiscard]] std::string getRawContent() const { return std::string(this->_rawContent); }
+
+        [[nodiscard]] const Tree& getTree() const { return this->_tree; }
 
     private:
         const std::string _filepath;
-        std::string _rawContent;
+        std::pmr::string _rawContent;
         Tree _tree;
 
         /**
          * @brief   Reads the content of a file into a string.
          *
          * @param   filepath    The path to the file to read
-         * @returns The content of the file as a std::string.
+         * @param   content     The string to fill, which keeps its allocator
          * @throws  exception::CouldNotOpenFile If file could not be opened for
          *                                      some reason
          */
-        static std::string getFileContent(const std::string& filepath);
+        static void getFileContent(const std::string& filepath, std::pmr::string& content);
+
+        /**
+         * @brief   Parses the raw content against a schema.
+         */
+        std::vector<schema::Violation> validate(const Schema& schema, bool failFast, uint8_t nestingLevel);
     };
 
 }
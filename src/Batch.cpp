@@ -0,0 +1,107 @@
+#include "yml/Batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace yml
+{
+
+    void
+    LoadResult::rethrow()
+        const
+    {
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+    }
+
+    void
+    parallelFor
+    (
+        const size_t count,
+        size_t threads,
+        const std::function<void(size_t)>& fn
+    )
+    {
+        std::atomic<size_t> next = 0;
+        std::vector<std::thread> workers;
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, count);
+
+        const auto work = [&next, count, &fn]() {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        };
+
+        // The calling thread is one of the workers, hence the `1`.
+        try {
+            for (size_t i = 1; i < threads; ++i) {
+                workers.emplace_back(work);
+            }
+        } catch (...) {
+            // The workers started refer to this frame: stop handing them
+            // indices, and wait for them before it goes away.
+            next = count;
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            throw;
+        }
+        work();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::vector<LoadResult>
+    loadAll
+    (
+        const std::vector<std::string>& filepaths,
+        const size_t threads,
+        const uint8_t nestingLevel,
+        std::pmr::memory_resource* resource
+    )
+    {
+        std::vector<LoadResult> results;
+
+        results.reserve(filepaths.size());
+        for (const auto& filepath : filepaths) {
+            results.push_back({ filepath, Yml(resource), nullptr });
+        }
+
+        parallelFor(filepaths.size(), threads, [&](const size_t i) {
+            LoadResult& result = results[i];
+
+            try {
+                result.yml.loadFromFilepath(result.filepath, nestingLevel);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+        });
+        return results;
+    }
+
+    std::future<Yml>
+    loadAsync
+    (
+        std::string filepath,
+        const io::Backend backend,
+        const uint8_t nestingLevel,
+        std::pmr::memory_resource* resource
+    )
+    {
+        return std::async(std::launch::async, [filepath = std::move(filepath), backend, nestingLevel, resource] {
+            Yml yml(resource);
+
+            yml.loadFromFilepath(filepath, nestingLevel, backend);
+            return yml;
+        });
+    }
+
+}
@@ -0,0 +1,81 @@
+#include "yml/Diff.h"
+
+#include <algorithm>
+
+namespace yml
+{
+
+    static
+    void
+    diffTrees
+    (
+        const Tree& oldTree,
+        const Tree& newTree,
+        std::string& path,
+        Diff& result
+    )
+    {
+        const size_t prefix = path.size();
+
+        if (oldTree.hash() == newTree.hash()) {
+            return;
+        }
+
+        const auto enter = [&path, prefix](const std::string_view name) {
+            path.resize(prefix);
+            if (prefix != 0) {
+                path += '.';
+            }
+            path += name;
+        };
+
+        for (const Node& newNode : newTree.getNodes()) {
+            const auto oldNode = oldTree.find(newNode.name);
+
+            if (oldNode && oldNode->get().hash() == newNode.hash()) {
+                continue;
+            }
+
+            enter(newNode.name);
+            if (!oldNode) {
+                result.added.push_back(path);
+                continue;
+            }
+
+            const Node& old = oldNode->get();
+
+            if (old.value != newNode.value || old.type != newNode.type || old.isList != newNode.isList) {
+                result.changed.push_back(path);
+            }
+            diffTrees(old.children, newNode.children, path, result);
+        }
+
+        for (const Node& oldNode : oldTree.getNodes()) {
+            if (!newTree.find(oldNode.name)) {
+                enter(oldNode.name);
+                result.removed.push_back(path);
+            }
+        }
+
+        path.resize(prefix);
+    }
+
+    Diff
+    diff
+    (
+        const Tree& oldTree,
+        const Tree& newTree
+    )
+    {
+        Diff result;
+        std::string path;
+
+        diffTrees(oldTree, newTree, path, result);
+
+        std::sort(result.added.begin(), result.added.end());
+        std::sort(result.removed.begin(), result.removed.end());
+        std::sort(result.changed.begin(), result.changed.end());
+        return result;
+    }
+
+}
@@ -0,0 +1,128 @@
+#include "yml/Frozen.h"
+#include "yml/Parser.h"
+
+#include <limits>
+#include <unordered_map>
+
+namespace yml
+{
+
+    FrozenYml::FrozenYml
+    (
+        const Tree& tree
+    )
+    {
+        std::unordered_map<std::string_view, uint32_t> strings; // blob offsets
+        std::unordered_map<const Tree::Children*, size_t> shared; // first record of shared subtrees
+        std::vector<const Tree*> subtrees; // subtrees[i]: children of record i
+        std::vector<const Node*> children;
+        std::vector<const Node*> slots;
+        std::vector<std::string_view> names;
+        PerfectHash hash;
+
+        const auto intern = [this, &strings](const std::string_view str) {
+            const auto [it, inserted] = strings.try_emplace(str, this->_blob.size());
+
+            if (inserted) {
+                this->_blob.insert(this->_blob.end(), str.begin(), str.end());
+            }
+            return it->second;
+        };
+
+        this->_records.push_back({ 0, 0, 0, 0, 0, 0, frozen::NO_SEEDS, node::OBJECT, false });
+        subtrees.push_back(&tree);
+
+        // Breadth-first, so that the children of a record are contiguous.
+        for (size_t i = 0; i < subtrees.size(); ++i) {
+            bool list = false;
+
+            // Aliases point to the records of the subtree they share.
+            if (subtrees[i]->isShared()) {
+                const auto [it, inserted] = shared.try_emplace(&subtrees[i]->getNodes(), i);
+
+                if (!inserted) {
+                    this->_records[i].firstChild = this->_records[it->second].firstChild;
+                    this->_records[i].childCount = this->_records[it->second].childCount;
+                    this->_records[i].seedOffset = this->_records[it->second].seedOffset;
+                    continue;
+                }
+            }
+
+            children.clear();
+            names.clear();
+            for (const Node& node : subtrees[i]->getNodes()) {
+                children.push_back(&node);
+                names.emplace_back(node.name);
+                list |= node.isList;
+            }
+
+            // Store the children in slot order, so that the slot of a name
+            // is directly the position of the child. Lists keep their order.
+            if (!children.empty() && !list && hash.build(names)) {
+                slots.assign(children.size(), nullptr);
+                for (const Node* node : children) {
+                    slots[hash.slot(node->name)] = node;
+                }
+                children.swap(slots);
+
+                this->_records[i].seedOffset = static_cast<uint32_t>(this->_seeds.size());
+                this->_seeds.insert(this->_seeds.end(), hash.seeds().begin(), hash.seeds().end());
+            }
+
+            this->_records[i].firstChild = static_cast<uint32_t>(this->_records.size());
+            this->_records[i].childCount = static_cast<uint32_t>(children.size());
+
+            for (const Node* node : children) {
+                this->_records.push_back({
+                    intern(node->name),
+                    static_cast<uint32_t>(node->name.size()),
+                    intern(node->value),
+                    static_cast<uint32_t>(node->value.size()),
+                    0, 0,
+                    frozen::NO_SEEDS,
+                    node->type,
+                    node->isList
+                });
+                subtrees.push_back(&node->children);
+            }
+
+            if (this->_records.size() >= std::numeric_limits<uint32_t>::max()
+                || this->_blob.size() >= std::numeric_limits<uint32_t>::max()
+                || this->_seeds.size() >= std::numeric_limits<uint32_t>::max()) {
+                throw std::length_error("Document too large to be frozen");
+            }
+        }
+
+        this->_records.shrink_to_fit();
+        this->_blob.shrink_to_fit();
+        this->_seeds.shrink_to_fit();
+    }
+
+    std::optional<FrozenNode>
+    FrozenYml::getNode
+    (
+        const std::string_view search
+    )
+        const
+    {
+        std::optional<FrozenNode> current = this->root();
+        std::string_view rest = search;
+        std::string_view part;
+
+        while (current && Parser::nextToken(rest, '.', part)) {
+            current = current->find(part);
+        }
+        return current;
+    }
+
+    size_t
+    FrozenYml::footprint()
+        const
+    {
+        return sizeof(*this)
+            + this->_records.capacity() * sizeof(frozen::Record)
+            + this->_blob.capacity()
+            + this->_seeds.capacity() * sizeof(uint32_t);
+    }
+
+}
@@ -1,45 +1,587 @@
 #include "yml/Node.h"
+#include "yml/Hash.h"
 #include "yml/Yml.h"
 
+#include <cctype>
+#include <charconv>
 #include <iostream>
-#include <sstream>
+#include <unordered_map>
+#include <utility>
 
 namespace yml
 {
 
+    /**
+     * @brief   Checks if a string starts with a T, the way `std::istream >> T`
+     *          would read it, but without building a stream.
+     *
+     * Like a stream, and unlike std::from_chars, does not read `inf` or
+     * `nan`: numbers start with a digit or a dot, after at most one sign.
+     */
+    template<typename T>
+    static
+    bool
+    startsWithNumber
+    (
+        std::string_view str
+    )
+    {
+        T result{};
+
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) {
+            str.remove_prefix(1);
+        }
+        if (str.starts_with('+')) {
+            str.remove_prefix(1);
+            if (str.starts_with('-')) {
+                return false; // One sign only
+            }
+        }
+
+        const size_t digits = str.starts_with('-');
+
+        if (str.size() <= digits || (!std::isdigit(static_cast<unsigned char>(str[digits])) && str[digits] != '.')) {
+            return false;
+        }
+        return std::from_chars(str.data(), str.data() + str.size(), result).ec == std::errc();
+    }
+
+    struct Tree::Index
+    {
+        using Names = std::pmr::unordered_map<
+            std::pmr::string,
+            size_t,
+            StringHash,
+            std::equal_to<>
+        >;
+
+        Names names;                    /// Position of each named child
+        PerfectHash perfect;            /// Empty unless sealed
+        std::pmr::vector<size_t> slots; /// Positions by perfect slot
+
+        explicit Index(const allocator_type& alloc)
+            : names(alloc), perfect(alloc), slots(alloc)
+        {}
+    };
+
+    Tree::Tree
+    (
+        const Tree &other,
+        const allocator_type &alloc
+    )
+        : _children(other._children, alloc)
+    {
+        if (other._shared) {
+            this->view(other._shared);
+        }
+        this->adopt();
+        this->reindex();
+        this->_hash = other._hash;
+        this->_hashed = other._hashed;
+    }
+
+    Tree::Tree
+    (
+        Tree &&other
+    )
+        noexcept
+        : _children(std::move(other._children)),
+          _shared(std::move(other._shared)),
+          _index(std::exchange(other._index, nullptr)),
+          _hash(other._hash),
+          _hashed(other._hashed),
+          _sealed(std::exchange(other._sealed, false))
+    {
+        // The owner of other, if any, is being moved as well.
+        other._hashed = false;
+        this->adopt();
+    }
+
+    Tree::Tree
+    (
+        Tree &&other,
+        const allocator_type &alloc
+    )
+        : _children(std::move(other._children), alloc)
+    {
+        // Positions stay valid whether the nodes were moved one by one or not,
+        // but the index must live in the memory resource of this tree.
+        if (alloc == other.get_allocator()) {
+            this->_shared = std::move(other._shared);
+            this->_index = std::exchange(other._index, nullptr);
+            this->_sealed = std::exchange(other._sealed, false);
+        } else {
+            if (other._shared) {
+                this->view(std::move(other._shared));
+            }
+            this->reindex();
+        }
+        this->_hash = other._hash;
+        this->_hashed = std::exchange(other._hashed, false);
+        this->adopt();
+    }
+
+    Tree &
+    Tree::operator=
+    (
+        const Tree &other
+    )
+    {
+        if (this != &other) {
+            this->_shared.reset();
+            this->_children = other._children;
+            if (other._shared) {
+                this->view(other._shared);
+            }
+            this->adopt();
+            this->reindex();
+            this->invalidateHash();
+            this->_hash = other._hash;
+            this->_hashed = other._hashed;
+        }
+        return *this;
+    }
+
+    Tree &
+    Tree::operator=
+    (
+        Tree &&other
+    )
+    {
+        if (this != &other) {
+            this->_shared.reset();
+            this->_children = std::move(other._children);
+            this->dropIndex();
+            if (this->get_allocator() == other.get_allocator()) {
+                this->_shared = std::move(other._shared);
+                this->_index = std::exchange(other._index, nullptr);
+                this->_sealed = std::exchange(other._sealed, false);
+            } else {
+                if (other._shared) {
+                    this->view(std::move(other._shared));
+                }
+                this->reindex();
+            }
+            this->adopt();
+            this->invalidateHash();
+            this->_hash = other._hash;
+            this->_hashed = other._hashed;
+            other.nuke();
+        }
+        return *this;
+    }
+
+    Tree::~Tree()
+    {
+        this->dropIndex();
+    }
+
+    Node &
+    Tree::addNode(const Node &node)
+    {
+        this->detach();
+        if (!node.isList) {
+            if (Node* existing = this->findName(node.name)) {
+                return *existing;
+            }
+        }
+        return this->addNode(Node(node, this->get_allocator()));
+    }
+
+    Node &
+    Tree::addNode(Node &&node)
+    {
+        this->detach();
+        if (!node.isList) {
+            if (Node* existing = this->findName(node.name)) {
+                return *existing;
+            }
+        }
+
+        const Node* storage = this->_children.data();
+
+        this->unseal();
+        this->invalidateHash();
+        this->_children.push_back(std::move(node));
+        if (this->_children.data() != storage) {
+            this->adopt(); // Every node was moved.
+        }
+
+        Node& added = this->_children.back();
+
+        added._container = this;
+        if (added.isList) {
+            return added;
+        }
+        if (this->_index != nullptr) {
+            this->_index->names.try_emplace(added.name, this->_children.size() - 1);
+        } else {
+            this->reindex();
+        }
+        return added;
+    }
+
+    void
+    Tree::reserve(const size_t count)
+    {
+        this->detach();
+
+        const Node* storage = this->_children.data();
+
+        this->_children.reserve(count);
+        if (this->_children.data() != storage) {
+            this->adopt();
+        }
+    }
+
+    bool
+    Tree::erase
+    (
+        const std::string_view name
+    )
+    {
+        const Node* node = this->lookup(name);
+
+        if (node == nullptr) {
+            return false; // A view stays one.
+        }
+        node = &this->own(*node);
+        this->_children.erase(this->_children.begin() + (node - this->_children.data()));
+        this->invalidateHash();
+        this->adopt();
+        this->reindex();
+        return true;
+    }
+
+    void
+    Tree::nuke()
+    {
+        this->_shared.reset();
+        this->dropIndex();
+        this->invalidateHash();
+        this->_children.clear();
+    }
+
+    std::shared_ptr<const Tree>
+    Tree::share()
+    {
+        if (!this->_shared) {
+            const uint64_t hash = this->_hash;
+            const bool hashed = this->_hashed;
+
+            this->_shared = std::allocate_shared<Tree>(
+                std::pmr::polymorphic_allocator<Tree>(this->get_allocator()),
+                std::move(*this)
+            );
+            this->dropIndex();
+            this->_children.clear();
+            // Same content: the fingerprint, and those above it, still hold.
+            this->_hash = hash;
+            this->_hashed = hashed;
+        }
+        return this->_shared;
+    }
+
+    void
+    Tree::view
+    (
+        std::shared_ptr<const Tree> shared
+    )
+    {
+        this->dropIndex();
+        this->_children.clear();
+        this->invalidateHash();
+
+        if (shared && shared->_shared) {
+            shared = shared->_shared; // Views never chain.
+        }
+        // A tree never points to memory of another resource than its own.
+        if (shared && shared->get_allocator() != this->get_allocator()) {
+            this->_shared.reset();
+            this->_children = shared->_children;
+            this->adopt();
+            this->reindex();
+            return;
+        }
+        this->_shared = std::move(shared);
+    }
+
+    void
+    Tree::detach()
+    {
+        if (!this->_shared) {
+            return;
+        }
+
+        const std::shared_ptr<const Tree> shared = std::move(this->_shared);
+
+        this->_shared.reset();
+        this->_children.reserve(shared->_children.size());
+        // Only this level is copied: the subtrees below stay shared until
+        // they are changed in turn.
+        for (const Node& node : shared->_children) {
+            Node& copy = this->_children.emplace_back(std::string_view(), std::string_view());
+
+            copy.name = node.name;
+            copy.value = node.value;
+            copy.isList = node.isList;
+            copy.type = node.type;
+            if (!node.children.empty()) {
+                copy.children.view(std::shared_ptr<const Tree>(shared, &node.children));
+                copy.children._hash = node.children._hash;
+                copy.children._hashed = node.children._hashed;
+            }
+            copy._hash = node._hash;
+            copy._hashed = node._hashed;
+        }
+        this->adopt();
+        this->reindex();
+        // Same content, so the fingerprint still holds. It is dropped, up to
+        // the root, by the change that follows.
+    }
+
+    void
+    Tree::seal()
+    {
+        std::vector<std::string_view> keys;
+
+        this->unseal();
+        if (this->_shared) {
+            return; // Immutable, and possibly read from other threads.
+        }
+        for (Node& node : this->_children) {
+            node.children.seal();
+        }
+        this->_sealed = true;
+
+        // Small trees are scanned linearly, which is as fast as one probe.
+        if (this->_index == nullptr) {
+            return;
+        }
+
+        keys.reserve(this->_index->names.size());
+        for (const auto& [name, _] : this->_index->names) {
+            keys.emplace_back(name);
+        }
+        if (!this->_index->perfect.build(keys)) {
+            return; // Lookups fall back to the hash map.
+        }
+
+        // Reorder the positions so that each one sits at the slot of its name.
+        this->_index->slots.assign(keys.size(), 0);
+        for (const auto& [name, position] : this->_index->names) {
+            this->_index->slots[this->_index->perfect.slot(name)] = position;
+        }
+    }
+
+    uint64_t
+    Tree::hash()
+        const noexcept
+    {
+        if (this->_hashed) {
+            return this->_hash;
+        }
+        if (this->_shared) {
+            // Computed once for every view, but cached by each of them so
+            // that invalidateHash() knows to go up from here.
+            this->_hash = this->_shared->hash();
+            this->_hashed = true;
+            return this->_hash;
+        }
+
+        this->_hash = 0;
+        for (size_t i = 0; i < this->_children.size(); ++i) {
+            const Node& node = this->_children[i];
+
+            // A sum, so that the order of the children does not matter,
+            // except for list items which are seeded with their position.
+            this->_hash += hash::mix(node.hash(), node.isList ? i + 1 : 0);
+        }
+        this->_hashed = true;
+        return this->_hash;
+    }
+
+    void
+    Tree::invalidateHash()
+        noexcept
+    {
+        // A stale fingerprint implies stale ones all the way up.
+        if (!this->_hashed) {
+            return;
+        }
+        this->_hashed = false;
+        if (this->_owner != nullptr) {
+            this->_owner->invalidateHash();
+        }
+    }
+
+    void
+    Tree::unseal()
+        noexcept
+    {
+        this->_sealed = false;
+        if (this->_index != nullptr) {
+            this->_index->perfect.clear();
+            this->_index->slots.clear();
+        }
+    }
+
+    void
+    Tree::adopt()
+        noexcept
+    {
+        for (Node& node : this->_children) {
+            node._container = this;
+        }
+    }
+
     void
-    Tree::addNode(Node &node)
+    Tree::reindex()
+    {
+        size_t names = 0;
+
+        this->dropIndex();
+        for (const Node& node : this->_children) {
+            names += !node.isList;
+        }
+        if (names < INDEX_THRESHOLD) {
+            return;
+        }
+
+        this->_index = this->get_allocator().new_object<Index>(this->get_allocator());
+        for (size_t i = 0; i < this->_children.size(); ++i) {
+            if (!this->_children[i].isList) {
+                this->_index->names.try_emplace(this->_children[i].name, i);
+            }
+        }
+    }
+
+    void
+    Tree::dropIndex()
+        noexcept
+    {
+        this->_sealed = false;
+        if (this->_index != nullptr) {
+            this->get_allocator().delete_object(this->_index);
+            this->_index = nullptr;
+        }
+    }
+
+    Node *
+    Tree::findName
+    (
+        const std::string_view name
+    )
+        const noexcept
+    {
+        if (this->_shared) {
+            return this->_shared->findName(name);
+        }
+
+        // The nodes are only read here; constness is restored by the callers.
+        auto& children = const_cast<Children&>(this->_children);
+
+        if (this->_index == nullptr) {
+            for (Node& node : children) {
+                if (!node.isList && node.name == name) {
+                    return &node;
+                }
+            }
+            return nullptr;
+        }
+
+        if (!this->_index->perfect.empty()) {
+            Node& node = children[this->_index->slots[this->_index->perfect.slot(name)]];
+
+            return node.name == name ? &node : nullptr;
+        }
+
+        const auto it = this->_index->names.find(name);
+
+        return it == this->_index->names.end() ? nullptr : &children[it->second];
+    }
+
+    Node *
+    Tree::lookup
+    (
+        const std::string_view name
+    )
+        const noexcept
+    {
+        if (this->_shared) {
+            return this->_shared->lookup(name);
+        }
+        if (Node* node = this->findName(name)) {
+            return node;
+        }
+        if (this->_index != nullptr && this->_index->names.size() == this->_children.size()) {
+            return nullptr; // No list items.
+        }
+
+        for (const Node& node : this->_children) {
+            if (node.isList && node.name == name) {
+                return const_cast<Node*>(&node);
+            }
+        }
+        return nullptr;
+    }
+
+    std::optional<std::reference_wrapper<Node>>
+    Tree::find
+    (
+        const std::string_view name
+    )
+    {
+        const Node* node = this->lookup(name);
+
+        if (node == nullptr) {
+            return std::nullopt;
+        }
+        return this->own(*node);
+    }
+
+    std::optional<std::reference_wrapper<const Node>>
+    Tree::find
+    (
+        const std::string_view name
+    )
+        const noexcept
     {
-        this->_children.insert({ node.name, node });
+        const Node* node = this->lookup(name);
+
+        if (node == nullptr) {
+            return std::nullopt;
+        }
+        return *node;
     }
 
     Node &
     Tree::operator[]
     (
-        const std::string &name
+        const std::string_view name
     )
     {
-        auto it = this->_children.find(name);
+        const Node* node = this->lookup(name);
 
-        if (it == this->_children.end()) {
-            throw std::out_of_range("No such node: " + name);
+        if (node == nullptr) {
+            throw std::out_of_range("No such node: " + std::string(name));
         }
-        return it->second;
+        return this->own(*node);
     }
 
     const Node&
     Tree::operator[]
     (
-        const std::string &name
+        const std::string_view name
     )
         const
     {
-        auto it = this->_children.find(name);
+        const Node* node = this->lookup(name);
 
-        if (it == this->_children.end()) {
-            throw std::out_of_range("No such node: " + name);
+        if (node == nullptr) {
+            throw std::out_of_range("No such node: " + std::string(name));
         }
-        return it->second;
+        return *node;
     }
 
     Node &
@@ -48,44 +590,140 @@ namespace yml
         const size_t index
     )
     {
-        if (index >= this->_children.size()) {
+        if (index >= this->size()) {
             throw std::out_of_range("Index out of range in Tree");
         }
-
-        auto it = this->_children.begin();
-        std::advance(it, index);
-        return it->second;
+        return this->own(this->getNodes()[index]);
     }
 
     const Node &
     Tree::operator[]
     (
-        size_t index
+        const size_t index
     )
         const
     {
-        if (index >= this->_children.size()) {
+        if (index >= this->size()) {
             throw std::out_of_range("Index out of range in Tree");
         }
+        return this->getNodes()[index];
+    }
 
-        auto it = this->_children.begin();
-        std::advance(it, index);
-        return it->second;
+    Node &
+    Tree::own
+    (
+        const Node &node
+    )
+    {
+        const size_t position = &node - this->self()._children.data();
+
+        // The nodes of a shared subtree must never be modified: copy them.
+        this->detach();
+        return this->_children[position];
     }
 
     Node::Node
     (
-        const std::string &name,
-        const std::string &value
+        const std::string_view name,
+        const std::string_view value,
+        const allocator_type &alloc
     )
+        : name(name, alloc), value(value, alloc), children(alloc)
     {
-        this->name = name;
-        this->value = value;
-
+        this->children._owner = this;
         this->detectList();
         this->detectType();
     }
 
+    Node::Node
+    (
+        const Node &other,
+        const allocator_type &alloc
+    )
+        : name(other.name, alloc),
+          value(other.value, alloc),
+          isList(other.isList),
+          type(other.type),
+          children(other.children, alloc),
+          _hash(other._hash),
+          _hashed(other._hashed)
+    {
+        this->children._owner = this;
+    }
+
+    Node::Node
+    (
+        Node &&other
+    )
+        noexcept
+        : name(std::move(other.name)),
+          value(std::move(other.value)),
+          isList(other.isList),
+          type(other.type),
+          children(std::move(other.children)),
+          _hash(other._hash),
+          _hashed(other._hashed)
+    {
+        this->children._owner = this;
+        other.invalidateHash();
+    }
+
+    Node::Node
+    (
+        Node &&other,
+        const allocator_type &alloc
+    )
+        : name(std::move(other.name), alloc),
+          value(std::move(other.value), alloc),
+          isList(other.isList),
+          type(other.type),
+          children(std::move(other.children), alloc),
+          _hash(other._hash),
+          _hashed(other._hashed)
+    {
+        this->children._owner = this;
+        other.invalidateHash();
+    }
+
+    Node &
+    Node::operator=
+    (
+        const Node &other
+    )
+    {
+        if (this != &other) {
+            this->name = other.name;
+            this->value = other.value;
+            this->isList = other.isList;
+            this->type = other.type;
+            this->children = other.children;
+            this->invalidateHash();
+            this->_hash = other._hash;
+            this->_hashed = other._hashed;
+        }
+        return *this;
+    }
+
+    Node &
+    Node::operator=
+    (
+        Node &&other
+    )
+    {
+        if (this != &other) {
+            this->name = std::move(other.name);
+            this->value = std::move(other.value);
+            this->isList = other.isList;
+            this->type = other.type;
+            this->children = std::move(other.children);
+            this->invalidateHash();
+            this->_hash = other._hash;
+            this->_hashed = other._hashed;
+            other.invalidateHash();
+        }
+        return *this;
+    }
+
     void
     Node::dump(const size_t depth)
         const
@@ -94,7 +732,7 @@ namespace yml
 
         if (this->isList) {
             std::cout << "- " << this->name;
-            if (!this->children.getNodes().empty()) {
+            if (!this->children.empty()) {
                 std::cout << ":";
             }
             std::cout << std::endl;
@@ -107,11 +745,53 @@ namespace yml
             std::cout << std::endl;
         }
 
-        for (const auto& [_, node] : this->children.getNodes()) {
+        for (const Node& node : this->children.getNodes()) {
             node.dump(depth + 1);
         }
     }
 
+    uint64_t
+    Node::hash()
+        const noexcept
+    {
+        if (this->_hashed) {
+            return this->_hash;
+        }
+
+        uint64_t h = hash::string(this->name);
+
+        h = hash::combine(h, hash::string(this->value));
+        h = hash::combine(h, static_cast<uint64_t>(this->type) << 1 | this->isList);
+        h = hash::combine(h, this->children.hash());
+        this->_hash = h;
+        this->_hashed = true;
+        return h;
+    }
+
+    void
+    Node::invalidateHash()
+        noexcept
+    {
+        if (!this->_hashed) {
+            return;
+        }
+        this->_hashed = false;
+        if (this->_container != nullptr) {
+            this->_container->invalidateHash();
+        }
+    }
+
+    void
+    Node::setValue
+    (
+        const std::string_view text
+    )
+    {
+        this->value = text;
+        this->detectType();
+        this->invalidateHash();
+    }
+
     void
     Node::detectList
     ()
@@ -123,7 +803,7 @@ namespace yml
         this->isList = (this->name[0] == '-' && this->name[1] == ' ');
 
         if (this->isList) {
-            this->name = this->name.substr(2);
+            this->name.erase(0, 2);
         }
     }
 
@@ -131,7 +811,7 @@ namespace yml
     Node::detectType
     ()
     {
-        if (!this->children.getNodes().empty()) {
+        if (!this->children.empty()) {
             this->type = this->isList ? node::LIST : node::OBJECT;
             return;
         }
@@ -145,22 +825,10 @@ namespace yml
             type = node::BOOLEAN;
         }
         else if (value.find('.') != std::string::npos) {
-            std::istringstream iss(value);
-            double d;
-            if (iss >> d) {
-                type = node::DOUBLE;
-            } else {
-                type = node::STRING;
-            }
+            type = startsWithNumber<double>(value) ? node::DOUBLE : node::STRING;
         }
         else {
-            std::istringstream iss(value);
-            int i;
-            if (iss >> i) {
-                type = node::INTEGER;
-            } else {
-                type = node::STRING;
-            }
+            type = startsWithNumber<int>(value) ? node::INTEGER : node::STRING;
         }
     }
 
@@ -0,0 +1,357 @@
+#include "yml/Overlay.h"
+#include "yml/Parser.h"
+
+namespace yml
+{
+
+    /**
+     * @returns True if path is below ancestor, in the tree.
+     */
+    static
+    bool
+    isBelow
+    (
+        const std::string_view path,
+        const std::string_view ancestor
+    )
+    {
+        return path.size() > ancestor.size() && path.starts_with(ancestor) && path[ancestor.size()] == '.';
+    }
+
+    static
+    std::string_view
+    lastPart
+    (
+        const std::string_view path
+    )
+    {
+        const size_t dot = path.rfind('.');
+
+        return dot == std::string_view::npos ? path : path.substr(dot + 1);
+    }
+
+    /**
+     * @brief   Sets or removes the node at a path below a tree.
+     *
+     * @param   tree    The tree path starts from
+     * @param   path    The dotted path of the node
+     * @param   node    The node to copy there, or null to remove the one
+     *                  there. Named after the last part of path.
+     */
+    static
+    void
+    place
+    (
+        Tree& tree,
+        std::string_view path,
+        const Node* node
+    )
+    {
+        Tree* current = &tree;
+        std::string_view part;
+
+        Parser::nextToken(path, '.', part);
+        for (std::string_view next; Parser::nextToken(path, '.', next); part = next) {
+            // Changes never reach the nodes that other trees share.
+            current->detach();
+
+            auto child = current->find(part);
+
+            if (!child) {
+                if (node == nullptr) {
+                    return; // Nothing to remove.
+                }
+                child = current->addNode(Node(part, "", current->get_allocator()));
+            }
+            current = &child->get().children;
+        }
+
+        current->detach();
+        if (node == nullptr) {
+            current->erase(part);
+        } else if (const auto existing = current->find(part)) {
+            existing->get() = *node;
+        } else {
+            current->addNode(*node);
+        }
+    }
+
+    Overlay::Overlay
+    (
+        std::shared_ptr<const Yml> base,
+        std::pmr::memory_resource* resource
+    )
+        : _base(std::move(base)), _changes(resource), _below(resource), _merged(resource)
+    {}
+
+    Overlay::Overlay
+    (
+        std::shared_ptr<const Overlay> lower,
+        std::pmr::memory_resource* resource
+    )
+        : _lower(std::move(lower)), _changes(resource), _below(resource), _merged(resource)
+    {}
+
+    void
+    Overlay::set
+    (
+        const std::string_view path,
+        const std::string_view value
+    )
+    {
+        const Node node(lastPart(path), value, this->_changes.get_allocator());
+
+        this->change(path, &node);
+    }
+
+    void
+    Overlay::set
+    (
+        const std::string_view path,
+        const Node& node
+    )
+    {
+        Node named(lastPart(path), node.value, this->_changes.get_allocator());
+
+        named.type = node.type;
+        named.children = node.children;
+        this->change(path, &named);
+    }
+
+    void
+    Overlay::remove
+    (
+        const std::string_view path
+    )
+    {
+        this->change(path, nullptr);
+    }
+
+    const Overlay::Change*
+    Overlay::cover
+    (
+        const std::string_view path,
+        std::string_view& rest
+    )
+        const noexcept
+    {
+        if (this->_changes.empty()) {
+            return nullptr;
+        }
+        // The prefixes of path are views of it: looking them up allocates
+        // nothing.
+        for (size_t end = path.find('.');; end = path.find('.', end + 1)) {
+            const auto it = this->_changes.find(path.substr(0, end));
+
+            if (it != this->_changes.end()) {
+                rest = end == std::string_view::npos ? std::string_view() : path.substr(end + 1);
+                return &it->second;
+            }
+            if (end == std::string_view::npos) {
+                return nullptr;
+            }
+        }
+    }
+
+    void
+    Overlay::change
+    (
+        const std::string_view path,
+        const Node* node
+    )
+    {
+        const auto alloc = this->_changes.get_allocator();
+        std::string_view rest;
+
+        this->_merged.nodes.clear();
+        if (const Change* covering = this->cover(path, rest)) {
+            // Only the constness added by cover() is removed.
+            auto& found = const_cast<Change&>(*covering);
+
+            if (rest.data() == nullptr) {
+                found.removed = node == nullptr;
+                if (node != nullptr) {
+                    found.node = *node;
+                }
+            } else if (!found.removed || node != nullptr) { // Else already hidden
+                if (found.removed) {
+                    found.removed = false;
+                    found.node = Node(found.node.name, "", alloc);
+                }
+                place(found.node.children, rest, node);
+            }
+            // Computed up front, so that the overlays above only read them.
+            static_cast<void>(found.node.hash());
+            return;
+        }
+
+        std::string_view key = path;
+
+        // A node added below missing parents is stored along with them, at
+        // the first one missing, so that they can be looked up too.
+        if (node != nullptr) {
+            for (size_t end = path.find('.'); end != std::string_view::npos; end = path.find('.', end + 1)) {
+                if (!this->lowerNode(path.substr(0, end))) {
+                    key = path.substr(0, end);
+                    break;
+                }
+            }
+        }
+
+        for (auto it = this->_changes.begin(); it != this->_changes.end();) {
+            if (isBelow(it->first, key)) {
+                this->count(it->first, -1);
+                it = this->_changes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        Change stored{ node != nullptr && key == path ? *node : Node(lastPart(key), "", alloc), node == nullptr };
+
+        if (key != path) {
+            place(stored.node.children, path.substr(key.size() + 1), node);
+        }
+        const auto [it, inserted] = this->_changes.insert_or_assign(std::pmr::string(key, alloc), std::move(stored));
+
+        if (inserted) {
+            this->count(key, 1);
+        }
+        static_cast<void>(it->second.node.hash());
+    }
+
+    void
+    Overlay::count
+    (
+        const std::string_view path,
+        const int delta
+    )
+    {
+        for (size_t end = path.find('.'); end != std::string_view::npos; end = path.find('.', end + 1)) {
+            const std::string_view ancestor = path.substr(0, end);
+
+            if (delta > 0) {
+                ++this->_below[std::pmr::string(ancestor, this->_below.get_allocator())];
+                continue;
+            }
+
+            const auto it = this->_below.find(ancestor);
+
+            if (--it->second == 0) {
+                this->_below.erase(it);
+            }
+        }
+    }
+
+    std::optional<std::reference_wrapper<const Node>>
+    Overlay::getNode
+    (
+        const std::string_view search
+    )
+        const
+    {
+        std::string_view rest;
+        const Change* change = this->cover(search, rest);
+
+        if (change == nullptr) {
+            if (!this->_below.empty() && this->_below.contains(search)) {
+                return this->mergedNode(search);
+            }
+            return this->lowerNode(search);
+        }
+        if (change->removed) {
+            return std::nullopt;
+        }
+
+        std::optional<std::reference_wrapper<const Node>> current = change->node;
+        std::string_view part;
+
+        while (current && Parser::nextToken(rest, '.', part)) {
+            current = current->get().find(part);
+        }
+        return current;
+    }
+
+    std::optional<std::reference_wrapper<const Node>>
+    Overlay::mergedNode
+    (
+        const std::string_view search
+    )
+        const
+    {
+        std::lock_guard lock(this->_merged.mutex);
+
+        if (const auto it = this->_merged.nodes.find(search); it != this->_merged.nodes.end()) {
+            return it->second;
+        }
+
+        const auto lower = this->lowerNode(search);
+
+        if (!lower) {
+            return std::nullopt; // Only removals below a missing node.
+        }
+
+        const Node& source = lower->get();
+        Node merged(source.name, source.value, this->_merged.nodes.get_allocator());
+        // Keeps what the viewed subtrees point into alive.
+        const std::shared_ptr<const void> owner = this->_lower
+            ? std::shared_ptr<const void>(this->_lower)
+            : std::shared_ptr<const void>(this->_base);
+
+        // Only the nodes on the way to the changes are copied, by place():
+        // the rest is viewed.
+        merged.isList = source.isList;
+        merged.type = source.type;
+        merged.children.view(std::shared_ptr<const Tree>(owner, &source.children));
+        for (const auto& [path, change] : this->_changes) {
+            if (isBelow(path, search)) {
+                place(merged.children, std::string_view(path).substr(search.size() + 1), change.removed ? nullptr : &change.node);
+            }
+        }
+
+        // Computed up front, as for changes.
+        static_cast<void>(merged.hash());
+        return this->_merged.nodes.try_emplace(
+            std::pmr::string(search, this->_merged.nodes.get_allocator()), std::move(merged)
+        ).first->second;
+    }
+
+    std::optional<std::reference_wrapper<const Node>>
+    Overlay::lowerNode
+    (
+        const std::string_view search
+    )
+        const
+    {
+        return this->_lower ? this->_lower->getNode(search) : this->_base->getNode(search);
+    }
+
+    void
+    Overlay::merge
+    (
+        Tree& tree
+    )
+        const
+    {
+        if (this->_lower) {
+            this->_lower->merge(tree);
+        } else {
+            tree = this->_base->getTree();
+        }
+
+        for (const auto& [path, change] : this->_changes) {
+            place(tree, path, change.removed ? nullptr : &change.node);
+        }
+    }
+
+    FrozenYml
+    Overlay::flatten()
+        const
+    {
+        Tree tree(this->_changes.get_allocator());
+
+        this->merge(tree);
+        return FrozenYml(tree);
+    }
+
+}
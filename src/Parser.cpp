@@ -1,9 +1,9 @@
 #include "yml/Parser.h"
 
-#include <sstream>
+#include "yml/Exceptions/SchemaViolation.h"
+
 #include <algorithm>
 #include <optional>
-#include <iostream>
 
 namespace yml
 {
@@ -39,77 +39,348 @@ namespace yml
         return tokens;
     }
 
+    bool
+    Parser::nextToken
+    (
+        std::string_view &str,
+        const char delim,
+        std::string_view &token
+    )
+    {
+        if (str.data() == nullptr) {
+            return false; // Past the last token.
+        }
+
+        const size_t end = str.find(delim);
+
+        token = str.substr(0, end);
+        token.remove_prefix(std::min(token.find_first_not_of(' '), token.size()));
+        str = end == std::string_view::npos
+            ? std::string_view()
+            : str.substr(end + 1);
+        return true;
+    }
+
     void
     Parser::parse
     (
-        const std::string &rawContent
+        const std::string_view rawContent
     )
     {
-        std::istringstream f(rawContent);
-        std::string needle;
+        this->finish(rawContent.substr(this->feed(rawContent)));
+    }
 
-        while (std::getline(f, needle)) {
-            if (shouldSkipLine(needle)) {
-                continue;
+    size_t
+    Parser::feed
+    (
+        const std::string_view content
+    )
+    {
+        size_t start = 0;
+
+        // Same lines as std::getline(), viewed in place.
+        for (size_t end = content.find('\n'); end != std::string_view::npos; end = content.find('\n', start)) {
+            const std::string_view needle = content.substr(start, end - start);
+
+            start = end + 1;
+            ++this->_line;
+            if (!shouldSkipLine(needle)) {
+                this->parseLine(needle);
             }
-            this->parseLine(needle);
         }
+        return start;
+    }
+
+    void
+    Parser::finish
+    (
+        const std::string_view rest
+    )
+    {
+        this->_line += !rest.empty();
+        if (!shouldSkipLine(rest)) {
+            this->parseLine(rest);
+        }
+        this->closeAnchors(0);
+        if (this->_schema) {
+            this->closeEntries(0);
+            this->checkRequired(Schema::ROOT, this->_tree, 0, {}, 0, this->_required);
+        }
+        // Fingerprints are cached on first use; computing them now keeps the
+        // loaded document safe to read from several threads.
+        static_cast<void>(this->_tree.hash());
     }
 
     void
     Parser::parseLine
     (
-        const std::string &needle
+        const std::string_view needle
     )
     {
         const size_t spaces = countLeadingSpaces(needle);
-        const std::vector<std::string> tokens = split(needle, ':');
+        std::string_view rest = needle;
+        std::string_view name;
+        std::string_view value;
+        std::string_view extra;
+
+        nextToken(rest, ':', name);
+        const bool item = !nextToken(rest, ':', value) && name.starts_with("- ");
+        if (item) {
+            value = name.substr(2); // A scalar list item: its text is its value.
+        }
 
-        if (tokens.empty() || tokens.size() > 2) {
+        if (nextToken(rest, ':', extra)) {
             throw; // TODO: Throw exception.
         }
 
-        Node node(
-            tokens.at(0),
-            tokens.size() == 2 ? tokens.at(1) : ""
-        );
+        const std::string_view anchor = takeAnchor(value);
+        const Anchor* alias = nullptr;
+        std::string itemName; // Only built for anchored or aliased list items.
 
-        this->placeNode(needle, node, spaces);
+        // The objects this line closes may be the anchors it refers to.
+        this->closeAnchors(spaces / this->_nestingLevel);
+        if (value.starts_with('*')) {
+            if (const auto it = this->_anchors.find(value.substr(1)); it != this->_anchors.end()) {
+                alias = &it->second;
+            }
+        }
+        if (alias) {
+            // Aliased objects have no value: list items keep the alias text.
+            value = alias->value.empty() && item ? value.substr(1) : alias->value;
+        }
+        if (item && (!anchor.empty() || alias)) {
+            itemName = "- ";
+            itemName += value; // Named after their value, like any scalar item.
+            name = itemName;
+            if (alias && alias->tree) {
+                value = {};
+            }
+        }
+
+        Node node(name, value, this->_tree.get_allocator());
+
+        // Attached before placing, so that the schema sees the children.
+        if (alias && alias->tree) {
+            node.children.view(alias->tree);
+        }
+
+        Node& placed = this->placeNode(needle, node, spaces);
+
+        if (!anchor.empty()) {
+            this->defineAnchor(anchor, placed);
+        }
+    }
+
+    std::string_view
+    Parser::takeAnchor
+    (
+        std::string_view &value
+    )
+    {
+        if (!value.starts_with('&')) {
+            return {};
+        }
+
+        const size_t end = std::min(value.find(' '), value.size());
+        const std::string_view anchor = value.substr(1, end - 1);
+
+        value.remove_prefix(end);
+        value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+        return anchor;
     }
 
     void
+    Parser::defineAnchor
+    (
+        const std::string_view name,
+        Node &node
+    )
+    {
+        if (!this->_parents.empty() && this->_parents.back() == &node) {
+            this->_pending.push_back({this->_parents.size() - 1, &node, std::string(name)});
+            return;
+        }
+        // A later definition replaces an earlier one, for the aliases after it.
+        this->_anchors.insert_or_assign(std::string(name), Anchor{nullptr, std::string(node.value)});
+    }
+
+    void
+    Parser::closeAnchors
+    (
+        const size_t level
+    )
+    {
+        while (!this->_pending.empty() && this->_pending.back().level >= level) {
+            PendingAnchor& pending = this->_pending.back();
+
+            this->_anchors.insert_or_assign(
+                std::move(pending.name),
+                Anchor{pending.node->children.share(), std::string(pending.node->value)}
+            );
+            this->_pending.pop_back();
+        }
+    }
+
+    Node&
     Parser::placeNode
     (
-        const std::string &needle,
+        const std::string_view needle,
         Node &node,
         size_t spaces
     )
     {
-        std::optional<std::reference_wrapper<Node>> parent = std::nullopt;
         const size_t depth = spaces / this->_nestingLevel;
+        const bool object = node.value.empty() && isObject(node.name, needle);
+
+        this->closeAnchors(depth);
+        if (this->_parents.size() > depth) {
+            if (this->_schema) {
+                this->closeEntries(depth);
+            }
+            this->_parents.resize(depth);
+        }
 
-        this->_currentPath.resize(getPathSize(this->_currentPath, depth));
+        // Only the children of the innermost parent can move, and it is
+        // never itself on the stack above depth.
+        Tree& tree = this->_parents.empty() ? this->_tree : this->_parents.back()->children;
+        const size_t size = tree.size();
+        Node& placed = tree.addNode(std::move(node));
+        uint32_t entry = Schema::NONE;
 
-        if (!this->_currentPath.empty()) {
-            parent = this->_ymlInstance.getNode(this->_currentPath);
+        if (this->_schema) {
+            entry = this->_schema->child(this->_entries.empty() ? Schema::ROOT : this->_entries.back().entry, placed.name);
+            if (entry != Schema::NONE && tree.size() != size && this->_schema->rule(entry).required) {
+                ++(this->_entries.empty() ? this->_required : this->_entries.back().required);
+            }
+            // Objects are checked once their children are known.
+            if (!object && entry != Schema::NONE) {
+                this->check(entry, placed, this->_parents.size(), this->_line, 0);
+            }
+        }
+
+        if (entry != Schema::NONE && placed.children.isShared()) {
+            // An alias: its children are never placed one by one.
+            this->checkShared(entry, placed.children, this->_parents.size(), placed.name);
+        }
+        if (object) {
+            this->_parents.push_back(&placed);
+            if (this->_schema) {
+                this->_entries.push_back({ entry, this->_line });
+            }
+        }
+        return placed;
+    }
+
+    void
+    Parser::closeEntries
+    (
+        const size_t level
+    )
+    {
+        for (size_t i = this->_entries.size(); i-- > level;) {
+            if (this->_entries[i].entry != Schema::NONE) {
+                const Frame& frame = this->_entries[i];
+
+                this->check(frame.entry, *this->_parents[i], i, frame.line, frame.required);
+            }
+        }
+        this->_entries.resize(std::min(level, this->_entries.size()));
+    }
+
+    void
+    Parser::check
+    (
+        const uint32_t entry,
+        const Node &node,
+        const size_t level,
+        const size_t line,
+        const size_t seen
+    )
+    {
+        std::string reason = this->_schema->check(entry, node);
+
+        if (!reason.empty()) {
+            this->report(level, node.name, line, std::move(reason));
+        }
+        this->checkRequired(entry, node.children, level, node.name, line, seen);
+    }
+
+    void
+    Parser::checkRequired
+    (
+        const uint32_t entry,
+        const Tree &children,
+        const size_t level,
+        const std::string_view name,
+        const size_t line,
+        const size_t seen
+    )
+    {
+        const std::span<const std::string> required = this->_schema->required(entry);
+
+        if (seen == required.size()) {
+            return; // Nothing to look for.
+        }
+        for (const std::string& child : required) {
+            if (!children.find(child)) {
+                this->report(level, name.empty() ? child : std::string(name) + "." + child, line, "missing");
+            }
         }
+    }
 
-        if (node.value.empty() && isObject(node.name, needle)) {
-            if (!this->_currentPath.empty()) {
-                this->_currentPath += ".";
+    void
+    Parser::checkShared
+    (
+        const uint32_t entry,
+        const Tree &children,
+        const size_t level,
+        const std::string_view name
+    )
+    {
+        for (const Node& child : children.getNodes()) {
+            const uint32_t childEntry = this->_schema->child(entry, child.name);
+
+            if (childEntry == Schema::NONE) {
+                continue;
             }
-            this->_currentPath += node.name;
+
+            const std::string path = std::string(name) + "." + std::string(child.name);
+            std::string reason = this->_schema->check(childEntry, child);
+
+            if (!reason.empty()) {
+                this->report(level, path, this->_line, std::move(reason));
+            }
+            this->checkRequired(childEntry, child.children, level, path, this->_line, 0);
+            this->checkShared(childEntry, child.children, level, path);
         }
+    }
+
+    void
+    Parser::report
+    (
+        const size_t level,
+        const std::string_view name,
+        const size_t line,
+        std::string reason
+    )
+    {
+        std::string path;
 
-        if (parent == std::nullopt) {
-            this->_tree.addNode(node);
-        } else {
-            parent.value().get().children.addNode(node);
+        // Only built for the nodes that break the rules.
+        for (size_t i = 0; i < level; ++i) {
+            path += this->_parents[i]->name;
+            path += '.';
         }
+        path += name;
+
+        if (this->_violations == nullptr) {
+            throw exception::SchemaViolation(path, reason, line);
+        }
+        this->_violations->push_back({ std::move(path), line, std::move(reason) });
     }
 
     size_t
-    Parser::countLeadingSpaces(const std::string &str)
+    Parser::countLeadingSpaces(const std::string_view str)
     {
         const auto it = std::find_if(
             str.begin(),
@@ -123,7 +394,7 @@ namespace yml
     }
 
     bool
-    Parser::shouldSkipLine(const std::string &needle)
+    Parser::shouldSkipLine(const std::string_view needle)
     {
         if (needle.empty()) {
             return true; // Empty line? Skip.
@@ -138,42 +409,20 @@ namespace yml
         return true; // Only spaces? Skip.
     }
 
-    size_t
-    Parser::getPathSize
-    (
-        const std::string &path,
-        const size_t n
-    )
-    {
-        size_t counter = 0;
-        size_t size = 0;
-
-        if (path.empty() || n == 0) {
-            return 0;
-        }
-
-        for (const char c : path) {
-            if (c == '.') {
-                counter++;
-            }
-            if (counter >= n) {
-                break;
-            }
-            size++;
-        }
-        return size;
-    }
-
     bool
     Parser::isObject
     (
-        const std::string &name,
-        const std::string &needle
+        const std::string_view name,
+        const std::string_view needle
     )
     {
-        const std::string n = name + ":";
-
-        return needle.find(n) != std::string::npos;
+        // Looks for `name:` without building that string.
+        for (size_t pos = needle.find(name); pos != std::string_view::npos; pos = needle.find(name, pos + 1)) {
+            if (pos + name.size() < needle.size() && needle[pos + name.size()] == ':') {
+                return true;
+            }
+        }
+        return false;
     }
 
 }
\ No newline at end of file
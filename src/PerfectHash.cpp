@@ -0,0 +1,86 @@
+#include "yml/PerfectHash.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace yml
+{
+
+    /// Gives up on a bucket after that many seeds. Only reached if two keys
+    /// share the same 64-bit hash.
+    static constexpr uint32_t MAX_SEED = 1u << 20;
+
+    bool
+    PerfectHash::build
+    (
+        const std::vector<std::string_view>& keys
+    )
+    {
+        const size_t n = keys.size();
+        std::vector<uint64_t> hashes(n);
+        std::vector<std::vector<size_t>> buckets(n);
+        std::vector<size_t> order(n);
+        std::vector<bool> taken(n, false);
+        std::vector<size_t> slots;
+
+        this->clear();
+        if (n == 0) {
+            return true;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = hash::string(keys[i]);
+            buckets[hash::mix(hashes[i]) % n].push_back(i);
+        }
+
+        // Biggest buckets first, while there is still room to place them.
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        this->_seeds.assign(n, 0);
+        for (const size_t b : order) {
+            const auto& bucket = buckets[b];
+            uint32_t seed = 1;
+
+            if (bucket.empty()) {
+                break;
+            }
+
+            for (; seed < MAX_SEED; ++seed) {
+                slots.clear();
+                for (const size_t key : bucket) {
+                    const size_t s = hash::mix(hashes[key], seed) % n;
+
+                    if (taken[s] || std::find(slots.begin(), slots.end(), s) != slots.end()) {
+                        break;
+                    }
+                    slots.push_back(s);
+                }
+                if (slots.size() == bucket.size()) {
+                    break;
+                }
+            }
+
+            if (seed == MAX_SEED) {
+                this->clear();
+                return false;
+            }
+            for (const size_t s : slots) {
+                taken[s] = true;
+            }
+            this->_seeds[b] = seed;
+        }
+
+        return true;
+    }
+
+    void
+    PerfectHash::clear()
+        noexcept
+    {
+        this->_seeds.clear();
+    }
+
+}
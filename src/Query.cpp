@@ -0,0 +1,173 @@
+#include "yml/Query.h"
+
+#include <charconv>
+
+namespace yml
+{
+
+    Query::Query
+    (
+        const std::string_view pattern
+    )
+        : _pattern(pattern)
+    {
+        std::string_view rest = pattern;
+
+        if (pattern.empty()) {
+            throw exception::InvalidQuery(this->_pattern, "empty pattern");
+        }
+
+        while (true) {
+            const size_t dot = rest.find('.');
+
+            this->compile(rest.substr(0, dot));
+            if (dot == std::string_view::npos) {
+                break;
+            }
+            rest.remove_prefix(dot + 1);
+        }
+    }
+
+    void
+    Query::compile
+    (
+        const std::string_view part
+    )
+    {
+        size_t bracket = part.find('[');
+        const std::string_view name = part.substr(0, bracket);
+
+        if (name == "**") {
+            // `**.**` is the same as `**`, and would only report duplicates.
+            if (this->_segments.empty() || this->_segments.back().kind != Segment::DESCEND) {
+                this->_segments.push_back({ Segment::DESCEND, {} });
+            }
+        } else if (name == "*") {
+            this->_segments.push_back({ Segment::ANY, {} });
+        } else if (!name.empty()) {
+            this->_segments.push_back({ Segment::NAME, std::string(name) });
+        } else if (bracket == std::string_view::npos) {
+            throw exception::InvalidQuery(this->_pattern, "empty segment");
+        }
+
+        while (bracket != std::string_view::npos) {
+            const size_t close = part.find(']', bracket);
+
+            if (close == std::string_view::npos) {
+                throw exception::InvalidQuery(this->_pattern, "unclosed '['");
+            }
+
+            const std::string_view inner = part.substr(bracket + 1, close - bracket - 1);
+            size_t index = 0;
+
+            if (inner == "*") {
+                this->_segments.push_back({ Segment::ANY, {} });
+            } else {
+                const auto [ptr, ec] = std::from_chars(inner.data(), inner.data() + inner.size(), index);
+
+                if (inner.empty() || ec != std::errc() || ptr != inner.data() + inner.size()) {
+                    throw exception::InvalidQuery(this->_pattern, "bad index '" + std::string(inner) + "'");
+                }
+                this->_segments.push_back({ Segment::INDEX, {}, index });
+            }
+
+            bracket = close + 1;
+            if (bracket == part.size()) {
+                break;
+            }
+            if (part[bracket] != '[') {
+                throw exception::InvalidQuery(this->_pattern, "unexpected characters after ']'");
+            }
+        }
+    }
+
+    size_t
+    Query::evaluate
+    (
+        const Tree& tree,
+        std::vector<const Node*>& matches
+    )
+        const
+    {
+        const size_t before = matches.size();
+
+        this->match(tree, 0, matches);
+        return matches.size() - before;
+    }
+
+    void
+    Query::match
+    (
+        const Tree& tree,
+        const size_t segment,
+        std::vector<const Node*>& matches
+    )
+        const
+    {
+        const Segment& current = this->_segments[segment];
+        const Tree::Children& children = tree.getNodes();
+
+        switch (current.kind) {
+            case Segment::NAME: {
+                const auto found = tree.find(current.name);
+
+                if (!found) {
+                    return;
+                }
+                this->matchNext(found->get(), segment, matches);
+
+                // Only list items share a name, and find() returns the first.
+                if (found->get().isList) {
+                    for (const Node* node = &found->get() + 1; node != children.data() + children.size(); ++node) {
+                        if (node->isList && std::string_view(node->name) == current.name) {
+                            this->matchNext(*node, segment, matches);
+                        }
+                    }
+                }
+                return;
+            }
+            case Segment::ANY:
+                for (const Node& node : children) {
+                    this->matchNext(node, segment, matches);
+                }
+                return;
+            case Segment::INDEX:
+                if (current.index < children.size()) {
+                    this->matchNext(children[current.index], segment, matches);
+                }
+                return;
+            case Segment::DESCEND:
+                // A trailing `**` matches every node below.
+                if (segment + 1 == this->_segments.size()) {
+                    for (const Node& node : children) {
+                        matches.push_back(&node);
+                        this->match(node.children, segment, matches);
+                    }
+                    return;
+                }
+
+                this->match(tree, segment + 1, matches);
+                for (const Node& node : children) {
+                    this->match(node.children, segment, matches);
+                }
+                return;
+        }
+    }
+
+    void
+    Query::matchNext
+    (
+        const Node& node,
+        const size_t segment,
+        std::vector<const Node*>& matches
+    )
+        const
+    {
+        if (segment + 1 == this->_segments.size()) {
+            matches.push_back(&node);
+        } else {
+            this->match(node.children, segment + 1, matches);
+        }
+    }
+
+}
@@ -0,0 +1,525 @@
+#include "yml/Reader.h"
+
+#include "yml/Exceptions/CouldNotOpenFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define YML_HAS_IO_URING 1
+
+    #include <atomic>
+    #include <cstring>
+    #include <optional>
+    #include <fcntl.h>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace yml::io
+{
+
+#if defined(YML_HAS_IO_URING)
+
+    namespace
+    {
+
+        /// Reads kept in flight at once.
+        constexpr unsigned QUEUE_DEPTH = 8;
+
+        [[noreturn]] void
+        throwErrno
+        (
+            const int error,
+            const char* what
+        )
+        {
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+        /**
+         * @brief   Minimal io_uring instance, driven through raw system calls
+         *          so that liburing is not needed.
+         */
+        class Ring final
+        {
+        public:
+            explicit Ring(const unsigned entries)
+            {
+                io_uring_params params{};
+
+                this->_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                if (this->_fd < 0) {
+                    throwErrno(errno, "io_uring_setup");
+                }
+                try {
+                    this->mapRings(params);
+                } catch (...) {
+                    this->release();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief   Waits for the reads in flight, which write to buffers
+             *          owned by the caller, then tears the ring down.
+             */
+            ~Ring()
+            {
+                this->drain();
+                this->release();
+            }
+
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            /**
+             * @brief   Queues a read. Sent to the kernel by the next enter().
+             */
+            void read(const int fd, char* buffer, const unsigned size, const uint64_t offset, const uint64_t tag)
+            {
+                const unsigned tail = *this->_sqTail;
+                const unsigned slot = tail & this->_sqMask;
+                io_uring_sqe& sqe = this->_sqes[slot];
+
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(buffer);
+                sqe.len = size;
+                sqe.off = offset;
+                sqe.user_data = tag;
+                this->_sqArray[slot] = slot;
+                std::atomic_ref(*this->_sqTail).store(tail + 1, std::memory_order_release);
+                ++this->_pending;
+            }
+
+            /**
+             * @brief   Submits the queued reads and waits for at least one
+             *          completion.
+             */
+            void enter()
+            {
+                const long submitted = syscall(
+                    __NR_io_uring_enter, this->_fd, this->_pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0
+                );
+
+                if (submitted < 0) {
+                    if (errno == EINTR) {
+                        return;
+                    }
+                    throwErrno(errno, "io_uring_enter");
+                }
+                this->_pending -= static_cast<unsigned>(submitted);
+                this->_submitted += static_cast<unsigned>(submitted);
+            }
+
+            /**
+             * @brief   Calls fn(tag, result) for every available completion.
+             */
+            template<typename Fn>
+            void reap(const Fn& fn)
+            {
+                unsigned head = *this->_cqHead;
+                const unsigned tail = std::atomic_ref(*this->_cqTail).load(std::memory_order_acquire);
+
+                while (head != tail) {
+                    const io_uring_cqe& cqe = this->_cqes[head & this->_cqMask];
+
+                    --this->_submitted;
+                    fn(cqe.user_data, cqe.res);
+                    ++head;
+                }
+                std::atomic_ref(*this->_cqHead).store(head, std::memory_order_release);
+            }
+
+        private:
+            int _fd = -1;
+            void* _sq = nullptr;
+            void* _cq = nullptr;
+            io_uring_sqe* _sqes = nullptr;
+            size_t _sqSize = 0;
+            size_t _cqSize = 0;
+            size_t _sqesSize = 0;
+            unsigned* _sqTail = nullptr;
+            unsigned _sqMask = 0;
+            unsigned* _sqArray = nullptr;
+            unsigned* _cqHead = nullptr;
+            unsigned* _cqTail = nullptr;
+            unsigned _cqMask = 0;
+            io_uring_cqe* _cqes = nullptr;
+            unsigned _pending = 0;      /// Reads queued, not yet submitted
+            unsigned _submitted = 0;    /// Reads submitted, not yet reaped
+
+            /**
+             * @brief   Waits for every submitted read to complete, dropping
+             *          their results.
+             *
+             * Queued reads that were never submitted are never seen by the
+             * kernel.
+             */
+            void drain() noexcept
+            {
+                while (this->_submitted > 0) {
+                    const long result = syscall(
+                        __NR_io_uring_enter, this->_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0
+                    );
+
+                    if (result < 0 && errno != EINTR) {
+                        return; // The ring itself is unusable.
+                    }
+                    this->reap([](uint64_t, int) {});
+                }
+            }
+
+            void release() noexcept
+            {
+                if (this->_sqes != nullptr) {
+                    munmap(this->_sqes, this->_sqesSize);
+                }
+                if (this->_cq != nullptr && this->_cq != this->_sq) {
+                    munmap(this->_cq, this->_cqSize);
+                }
+                if (this->_sq != nullptr) {
+                    munmap(this->_sq, this->_sqSize);
+                }
+                close(this->_fd);
+            }
+
+            void mapRings(const io_uring_params& params)
+            {
+                this->_sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                this->_cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                this->_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                if (params.features & IORING_FEAT_SINGLE_MMAP) {
+                    this->_sqSize = this->_cqSize = std::max(this->_sqSize, this->_cqSize);
+                }
+
+                this->_sq = this->map(this->_sqSize, IORING_OFF_SQ_RING);
+                this->_cq = (params.features & IORING_FEAT_SINGLE_MMAP)
+                    ? this->_sq
+                    : this->map(this->_cqSize, IORING_OFF_CQ_RING);
+                this->_sqes = static_cast<io_uring_sqe*>(this->map(this->_sqesSize, IORING_OFF_SQES));
+
+                auto* const sq = static_cast<char*>(this->_sq);
+                auto* const cq = static_cast<char*>(this->_cq);
+
+                this->_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                this->_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                this->_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                this->_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                this->_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                this->_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                this->_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            }
+
+            void* map(const size_t size, const off_t offset)
+            {
+                void* const ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->_fd, offset);
+
+                if (ptr == MAP_FAILED) {
+                    throwErrno(errno, "io_uring mmap");
+                }
+                return ptr;
+            }
+        };
+
+    }
+
+#endif
+
+    bool
+    isAvailable
+    (
+        const Backend backend
+    )
+        noexcept
+    {
+        if (backend == Backend::BLOCKING) {
+            return true;
+        }
+
+#if defined(YML_HAS_IO_URING)
+        static const bool available = [] {
+            io_uring_params params{};
+            const int fd = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+
+            if (fd < 0) {
+                return false;
+            }
+            close(fd);
+            // Set by the same kernels (5.6+) that support IORING_OP_READ.
+            return (params.features & IORING_FEAT_RW_CUR_POS) != 0;
+        }();
+
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    FileReader::FileReader
+    (
+        const std::string& filepath,
+        std::pmr::string& content,
+        const Backend backend,
+        const size_t blockSize,
+        std::function<void(size_t)> progress
+    )
+        : _content(content),
+          _data(nullptr),
+          _size(0),
+          _blockSize(std::max<size_t>(blockSize, 1)),
+          _backend(isAvailable(backend) ? backend : Backend::BLOCKING),
+          _onProgress(std::move(progress))
+    {
+        std::error_code error;
+        const bool regular = std::filesystem::is_regular_file(filepath, error);
+        const uintmax_t size = regular ? std::filesystem::file_size(filepath, error) : 0;
+        std::FILE* const file = std::fopen(filepath.c_str(), "rb");
+
+        if (file == nullptr) {
+            throw exception::CouldNotOpenFile(filepath);
+        }
+
+        content.clear();
+        if (error || size == 0) {
+            char buf[BUFSIZ];
+            size_t count;
+
+            // Size unknown: no way to lay the blocks out in advance.
+            while ((count = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+                content.append(buf, count);
+            }
+            std::fclose(file);
+            this->_ready = content.size();
+            this->_done = true;
+            return;
+        }
+
+        content.resize(size);
+        this->_data = content.data();
+        this->_size = content.size();
+
+#if defined(YML_HAS_IO_URING)
+        if (this->_backend == Backend::IO_URING) {
+            const int fd = dup(fileno(file));
+
+            std::fclose(file);
+            if (fd < 0) {
+                throw exception::CouldNotOpenFile(filepath);
+            }
+            this->_thread = std::thread(&FileReader::readUring, this, fd);
+            return;
+        }
+#endif
+        this->_thread = std::thread(&FileReader::readBlocking, this, file);
+    }
+
+    FileReader::~FileReader()
+    {
+        {
+            std::lock_guard lock(this->_mutex);
+            this->_cancel = true;
+        }
+        if (this->_thread.joinable()) {
+            this->_thread.join();
+        }
+    }
+
+    size_t
+    FileReader::wait
+    (
+        const size_t known
+    )
+    {
+        std::unique_lock lock(this->_mutex);
+
+        this->_progress.wait(lock, [this, known] {
+            return this->_ready > known || this->_done;
+        });
+        if (this->_ready > known && !this->_error) {
+            return this->_ready;
+        }
+
+        lock.unlock();
+        if (this->_thread.joinable()) {
+            this->_thread.join();
+        }
+        if (this->_error) {
+            std::rethrow_exception(this->_error);
+        }
+        this->_content.resize(this->_ready); // In case the file shrank
+        return this->_ready;
+    }
+
+    bool
+    FileReader::publish
+    (
+        const size_t ready
+    )
+    {
+        {
+            std::lock_guard lock(this->_mutex);
+
+            this->_ready = ready;
+            this->_progress.notify_one();
+            if (this->_cancel) {
+                return false;
+            }
+        }
+        if (this->_onProgress) {
+            this->_onProgress(ready);
+        }
+        return true;
+    }
+
+    void
+    FileReader::finish
+    (
+        std::exception_ptr error
+    )
+    {
+        std::lock_guard lock(this->_mutex);
+
+        this->_error = std::move(error);
+        this->_done = true;
+        this->_progress.notify_one();
+    }
+
+    void
+    FileReader::readBlocking
+    (
+        std::FILE* file
+    )
+    {
+        std::exception_ptr error;
+
+        try {
+            size_t offset = 0;
+
+            while (offset < this->_size) {
+                const size_t count = std::fread(
+                    this->_data + offset, 1, std::min(this->_blockSize, this->_size - offset), file
+                );
+
+                if (count == 0) {
+                    if (std::ferror(file)) {
+                        throw std::system_error(errno, std::generic_category(), "fread");
+                    }
+                    break; // The file shrank.
+                }
+                offset += count;
+                if (!this->publish(offset)) {
+                    break;
+                }
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        std::fclose(file);
+        this->finish(error);
+    }
+
+    void
+    FileReader::readUring
+    (
+        [[maybe_unused]] const int fd
+    )
+    {
+#if defined(YML_HAS_IO_URING)
+        std::exception_ptr error;
+        std::optional<Ring> ring;
+
+        try {
+            ring.emplace(QUEUE_DEPTH);
+        } catch (const std::system_error&) {
+            // Probed by isAvailable(), but setting a ring up can still fail,
+            // e.g. past RLIMIT_MEMLOCK. The file is read without it then.
+        }
+        if (!ring) {
+            std::FILE* const file = fdopen(fd, "rb");
+
+            if (file != nullptr) {
+                this->readBlocking(file);
+                return;
+            }
+            close(fd);
+            this->finish(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "fdopen")));
+            return;
+        }
+
+        try {
+            const size_t blocks = (this->_size + this->_blockSize - 1) / this->_blockSize;
+            std::vector<size_t> done(blocks, 0);    // Bytes read in each block
+            size_t next = 0;                        // Next block to queue
+            size_t complete = 0;                    // Blocks read in full, from the start
+            unsigned inFlight = 0;
+            bool stop = false;
+            int failure = 0;
+
+            const auto blockSize = [this, blocks](const size_t block) {
+                return block + 1 < blocks ? this->_blockSize : this->_size - block * this->_blockSize;
+            };
+            const auto queue = [&](const size_t block) {
+                const size_t offset = block * this->_blockSize + done[block];
+
+                ring->read(fd, this->_data + offset, static_cast<unsigned>(blockSize(block) - done[block]), offset, block);
+                ++inFlight;
+            };
+
+            // Reads must all have completed before the buffer may go away,
+            // so on cancellation the ring is drained first. On error, the
+            // ring drains itself as it is destroyed.
+            while (complete < blocks && !(stop && inFlight == 0)) {
+                while (!stop && inFlight < QUEUE_DEPTH && next < blocks) {
+                    queue(next++);
+                }
+
+                ring->enter();
+                ring->reap([&](const uint64_t block, const int result) {
+                    --inFlight;
+                    if (result < 0) {
+                        failure = -result;
+                        stop = true;
+                    } else if (result == 0) {
+                        stop = true; // The file shrank.
+                    } else {
+                        done[block] += static_cast<size_t>(result);
+                        if (done[block] < blockSize(block) && !stop) {
+                            queue(block); // Short read
+                        }
+                    }
+                });
+
+                const size_t before = complete;
+
+                while (complete < blocks && done[complete] == blockSize(complete)) {
+                    ++complete;
+                }
+                if (complete != before && !this->publish(std::min(complete * this->_blockSize, this->_size))) {
+                    stop = true;
+                }
+            }
+
+            if (failure != 0) {
+                throwErrno(failure, "io_uring read");
+            }
+            if (complete < blocks && done[complete] != 0) {
+                this->publish(complete * this->_blockSize + done[complete]);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        ring.reset(); // Before the owner of the content hears of the end.
+        close(fd);
+        this->finish(error);
+#endif
+    }
+
+}
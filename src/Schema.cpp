@@ -0,0 +1,216 @@
+#include "yml/Schema.h"
+#include "yml/Parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace yml
+{
+
+    /// Words of the types in YML schemas, indexed by node::Type.
+    static constexpr std::string_view TYPE_NAMES[] = {
+        "string", "integer", "number", "boolean", "object", "list", "any"
+    };
+
+    static
+    std::optional<double>
+    parseBound
+    (
+        const std::string_view text
+    )
+    {
+        double result = 0;
+        const char* const end = text.data() + text.size();
+        const auto [ptr, ec] = std::from_chars(text.data(), end, result);
+
+        if (text.empty() || ec != std::errc() || ptr != end) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    Schema::Schema()
+        : _entries(1)
+    {}
+
+    Schema::Schema
+    (
+        const Yml& definition
+    )
+        : _entries(1)
+    {
+        this->load(definition.getTree(), "");
+    }
+
+    void
+    Schema::load
+    (
+        const Tree& tree,
+        const std::string& prefix
+    )
+    {
+        for (const Node& node : tree.getNodes()) {
+            const std::string path = prefix.empty()
+                ? std::string(node.name)
+                : prefix + "." + std::string(node.name);
+
+            if (!node.value.empty()) {
+                this->add(path, parseRule(path, node.value));
+            }
+            this->load(node.children, path);
+        }
+    }
+
+    Schema&
+    Schema::add
+    (
+        const std::string_view path,
+        const schema::Rule& rule
+    )
+    {
+        std::string_view rest = path;
+        std::string_view part;
+        uint32_t parent = ROOT;
+        uint32_t entry = ROOT;
+
+        // Entries are referred to by index: adding one may move the others.
+        while (Parser::nextToken(rest, '.', part)) {
+            if (part.empty()) {
+                throw exception::InvalidSchema(std::string(path), "empty name");
+            }
+
+            const auto next = static_cast<uint32_t>(this->_entries.size());
+
+            parent = entry;
+            if (part == "*") {
+                if (this->_entries[parent].any == NONE) {
+                    this->_entries[parent].any = next;
+                }
+                entry = this->_entries[parent].any;
+            } else {
+                entry = this->_entries[parent].children.try_emplace(std::string(part), next).first->second;
+            }
+            if (entry == next) {
+                this->_entries.emplace_back();
+            }
+        }
+        if (entry == ROOT) {
+            throw exception::InvalidSchema(std::string(path), "empty path");
+        }
+
+        std::vector<std::string>& required = this->_entries[parent].required;
+        const auto it = std::find(required.begin(), required.end(), part);
+
+        this->_entries[entry].rule = rule;
+        this->_entries[entry].rule.required &= part != "*"; // Any name will do.
+        if (it != required.end()) {
+            required.erase(it);
+        }
+        if (this->_entries[entry].rule.required) {
+            required.emplace_back(part);
+        }
+        return *this;
+    }
+
+    schema::Rule
+    Schema::parseRule
+    (
+        const std::string_view path,
+        const std::string_view text
+    )
+    {
+        schema::Rule rule;
+        std::string_view rest = text;
+        std::string_view word;
+
+        while (Parser::nextToken(rest, ' ', word)) {
+            const auto type = std::find(std::begin(TYPE_NAMES), std::end(TYPE_NAMES), word);
+            std::optional<double>* bound = nullptr;
+
+            if (word.empty()) {
+                continue; // Several spaces in a row.
+            }
+            if (type != std::end(TYPE_NAMES)) {
+                rule.type = static_cast<node::Type>(type - std::begin(TYPE_NAMES));
+                continue;
+            }
+            if (word == "required") {
+                rule.required = true;
+                continue;
+            }
+
+            if (word.starts_with("min=")) {
+                bound = &rule.min;
+            } else if (word.starts_with("max=")) {
+                bound = &rule.max;
+            }
+            if (bound == nullptr || !(*bound = parseBound(word.substr(4)))) {
+                throw exception::InvalidSchema(std::string(path), std::format("unknown rule `{}`", word));
+            }
+        }
+        return rule;
+    }
+
+    uint32_t
+    Schema::child
+    (
+        const uint32_t parent,
+        const std::string_view name
+    )
+        const noexcept
+    {
+        if (parent == NONE) {
+            return NONE;
+        }
+
+        const Entry& entry = this->_entries[parent];
+        const auto it = entry.children.find(name);
+
+        return it != entry.children.end() ? it->second : entry.any;
+    }
+
+    std::string
+    Schema::check
+    (
+        const uint32_t entry,
+        const Node& node
+    )
+        const
+    {
+        const schema::Rule& rule = this->_entries[entry].rule;
+        const bool nested = !node.children.empty();
+        const bool list = nested && node.children.getNodes().front().isList;
+        bool ok = true;
+
+        switch (rule.type) {
+            case node::UNKNOWN: break;
+            case node::OBJECT:  ok = nested && !list; break;
+            case node::LIST:    ok = list; break;
+            case node::STRING:  ok = !nested; break;
+            case node::DOUBLE:  ok = !nested && (node.type == node::INTEGER || node.type == node::DOUBLE); break;
+            default:            ok = !nested && node.type == rule.type; break;
+        }
+        if (!ok) {
+            return std::format("expected {}", TYPE_NAMES[rule.type]);
+        }
+
+        if (rule.min || rule.max) {
+            // Parsing integers as such is cheaper, when they fit.
+            const std::optional<int> integer = node::tryConvert<int>(node.value, node.type);
+            const std::optional<double> number = integer ? *integer : node::tryConvert<double>(node.value, node.type);
+
+            if (!number) {
+                return "expected number";
+            }
+            if (rule.min && *number < *rule.min) {
+                return std::format("below the minimum of {}", *rule.min);
+            }
+            if (rule.max && *number > *rule.max) {
+                return std::format("above the maximum of {}", *rule.max);
+            }
+        }
+        return {};
+    }
+
+}
@@ -0,0 +1,184 @@
+#include "yml/Stream.h"
+#include "yml/Batch.h"
+
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace yml
+{
+
+    /**
+     * @returns True if line is the given marker, possibly followed by a
+     *          comment.
+     */
+    static
+    bool
+    isMarker
+    (
+        const std::string_view line,
+        const std::string_view marker
+    )
+    {
+        return line.starts_with(marker)
+            && (line.size() == marker.size() || line[marker.size()] == ' ' || line[marker.size()] == '\t');
+    }
+
+    static
+    bool
+    isBlank
+    (
+        const std::string_view line
+    )
+    {
+        const size_t start = line.find_first_not_of(" \t\r");
+
+        return start == std::string_view::npos || line[start] == '#';
+    }
+
+    Stream::Stream
+    (
+        std::string filepath,
+        const bool isRawContent,
+        const uint8_t nestingLevel,
+        std::pmr::memory_resource *resource
+    )
+        : _content(resource), _nestingLevel(nestingLevel)
+    {
+        if (isRawContent) {
+            this->_content = filepath;
+            this->scan(this->_content, true);
+            return;
+        }
+
+        io::FileReader reader(filepath, this->_content);
+        const char* const data = this->_content.data();
+
+        // Same as Yml::loadFromFilepath(): only the bytes reported are final.
+        for (size_t ready = 0, next; (next = reader.wait(ready)) != ready; ready = next) {
+            this->scan(std::string_view(data, next), false);
+        }
+        this->scan(this->_content, true);
+    }
+
+    void
+    Stream::scan
+    (
+        const std::string_view content,
+        const bool last
+    )
+    {
+        while (this->_scanned < content.size()) {
+            const size_t begin = this->_scanned;
+            size_t end = content.find('\n', begin);
+
+            if (end == std::string_view::npos) {
+                if (!last) {
+                    return; // The rest of the line is still being read.
+                }
+                end = content.size();
+            }
+
+            const std::string_view line = content.substr(begin, end - begin);
+
+            this->_scanned = std::min(end + 1, content.size());
+            if (isMarker(line, "---")) {
+                this->close(begin);
+                this->_start = this->_scanned;
+                this->_open = true; // Even if it turns out to be empty.
+            } else if (isMarker(line, "...")) {
+                this->close(begin);
+                this->_start = this->_scanned;
+            } else if (!this->_open && !isBlank(line)) {
+                this->_open = true;
+            }
+        }
+        if (last) {
+            this->close(content.size());
+        }
+    }
+
+    void
+    Stream::close
+    (
+        const size_t end
+    )
+    {
+        if (this->_open) {
+            this->_documents.push_back({ this->_start, end - this->_start });
+            this->_open = false;
+        }
+    }
+
+    std::string_view
+    Stream::raw
+    (
+        const size_t index
+    )
+        const
+    {
+        if (index >= this->_documents.size()) {
+            throw std::out_of_range("Index out of range in Stream");
+        }
+
+        const Document& document = this->_documents[index];
+
+        return std::string_view(this->_content).substr(document.offset, document.size);
+    }
+
+    Yml
+    Stream::load
+    (
+        const size_t index
+    )
+        const
+    {
+        Yml yml(this->_content.get_allocator().resource());
+
+        yml.loadFromRawContent(this->raw(index), this->_nestingLevel);
+        return yml;
+    }
+
+    void
+    Stream::forEach
+    (
+        const std::function<void(size_t, const Yml&)>& fn
+    )
+        const
+    {
+        Yml yml(this->_content.get_allocator().resource());
+
+        for (size_t i = 0; i < this->_documents.size(); ++i) {
+            yml.loadFromRawContent(this->raw(i), this->_nestingLevel);
+            fn(i, yml);
+        }
+    }
+
+    void
+    Stream::parallelForEach
+    (
+        const std::function<void(size_t, const Yml&)>& fn,
+        const size_t threads
+    )
+        const
+    {
+        std::mutex mutex;
+        std::exception_ptr error;
+
+        parallelFor(this->_documents.size(), threads, [&](const size_t i) {
+            try {
+                fn(i, this->load(i));
+            } catch (...) {
+                const std::lock_guard lock(mutex);
+
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+}
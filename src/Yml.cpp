@@ -3,9 +3,10 @@
 
 #include "yml/Exceptions/CouldNotOpenFile.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <utility>
 #include <fstream>
-#include <sstream>
 #include <iostream>
 
 namespace yml
@@ -15,9 +16,10 @@ namespace yml
     (
         std::string filepath,
         const bool isRawContent,
-        const uint8_t nestingLevel
+        const uint8_t nestingLevel,
+        std::pmr::memory_resource *resource
     )
-        : _filepath(std::move(filepath))
+        : _filepath(std::move(filepath)), _rawContent(resource), _tree(resource)
     {
         if (isRawContent) {
             this->loadFromRawContent(this->_filepath, nestingLevel);
@@ -26,6 +28,13 @@ namespace yml
         }
     }
 
+    Yml::Yml
+    (
+        std::pmr::memory_resource *resource
+    )
+        : _rawContent(resource), _tree(resource)
+    {}
+
     void
     Yml::loadFromFilepath
     (
@@ -34,14 +43,37 @@ namespace yml
     )
     {
         this->_tree.nuke();
-        this->_rawContent = getFileContent(filepath);
+        getFileContent(filepath, this->_rawContent);
         Parser parser(*this, this->_rawContent, this->_tree, nestingLevel);
     }
 
+    void
+    Yml::loadFromFilepath
+    (
+        const std::string& filepath,
+        const uint8_t nestingLevel,
+        const io::Backend backend
+    )
+    {
+        this->_tree.nuke();
+
+        io::FileReader reader(filepath, this->_rawContent, backend);
+        Parser parser(*this, this->_tree, nestingLevel);
+        const char* const data = this->_rawContent.data();
+        size_t parsed = 0;
+
+        // Only the bytes reported by the reader are final: the string itself
+        // must not be looked at until the whole file has been read.
+        for (size_t ready = 0, next; (next = reader.wait(ready)) != ready; ready = next) {
+            parsed += parser.feed(std::string_view(data + parsed, next - parsed));
+        }
+        parser.finish(std::string_view(this->_rawContent).substr(parsed));
+    }
+
     void
     Yml::loadFromRawContent
     (
-        const std::string &rawContent,
+        const std::string_view rawContent,
         const uint8_t nestingLevel
     )
     {
@@ -50,18 +82,88 @@ namespace yml
         Parser parser(*this, this->_rawContent, this->_tree, nestingLevel);
     }
 
+    std::vector<schema::Violation>
+    Yml::loadFromRawContent
+    (
+        const std::string_view rawContent,
+        const Schema& schema,
+        const bool failFast,
+        const uint8_t nestingLevel
+    )
+    {
+        this->_tree.nuke();
+        this->_rawContent = rawContent;
+        return this->validate(schema, failFast, nestingLevel);
+    }
+
+    std::vector<schema::Violation>
+    Yml::loadFromFilepath
+    (
+        const std::string& filepath,
+        const Schema& schema,
+        const bool failFast,
+        const uint8_t nestingLevel
+    )
+    {
+        this->_tree.nuke();
+        getFileContent(filepath, this->_rawContent);
+        return this->validate(schema, failFast, nestingLevel);
+    }
+
+    std::vector<schema::Violation>
+    Yml::validate
+    (
+        const Schema& schema,
+        const bool failFast,
+        const uint8_t nestingLevel
+    )
+    {
+        std::vector<schema::Violation> violations;
+        Parser parser(*this, this->_tree, nestingLevel, &schema, failFast ? nullptr : &violations);
+        const std::string_view content = this->_rawContent;
+
+        parser.finish(content.substr(parser.feed(content)));
+        return violations;
+    }
+
     std::optional<std::reference_wrapper<Node>>
     Yml::getNode
     (
-        const std::string &search
+        const std::string_view search
     )
     {
-        std::optional<std::reference_wrapper<Node>> current;
+        // Looked up read-only first, so that a miss detaches nothing.
+        if (!std::as_const(*this).getNode(search)) {
+            return std::nullopt;
+        }
+
+        Tree* tree = &this->_tree;
+        Node* node = nullptr;
+        std::string_view rest = search;
+        std::string_view part;
 
-        for (const auto& part : Parser::split(search, '.')) {
+        while (Parser::nextToken(rest, '.', part)) {
+            node = &tree->find(part)->get();
+            tree = &node->children;
+        }
+        return *node;
+    }
+
+    std::optional<std::reference_wrapper<const Node>>
+    Yml::getNode
+    (
+        const std::string_view search
+    )
+        const noexcept
+    {
+        std::optional<std::reference_wrapper<const Node>> current;
+        std::string_view rest = search;
+        std::string_view part;
+
+        while (Parser::nextToken(rest, '.', part)) {
             current = current
-                ? current->get().children[part]
-                : this->_tree[part];
+                ? current->get().find(part)
+                : this->_tree.find(part);
 
             if (current == std::nullopt) {
                 break;
@@ -75,29 +177,37 @@ namespace yml
     Yml::dump()
     {
         std::cout << "---=== YML Dump ===---\n" << std::endl;
-        for (const auto& [_, node] : this->_tree.getNodes()) {
+        for (const Node& node : this->_tree.getNodes()) {
             node.dump();
         }
         std::cout << "\n---=== -------- ===---" << std::endl;
     }
 
-    std::string
+    void
     Yml::getFileContent
     (
-        const std::string& filepath
+        const std::string& filepath,
+        std::pmr::string& content
     )
     {
-        std::stringstream buf;
         std::ifstream file(filepath);
+        char buf[BUFSIZ];
 
         if (!file.is_open()) {
             throw exception::CouldNotOpenFile(filepath);
         }
 
-        buf << file.rdbuf();
-        file.close();
+        content.clear();
+        if (file.seekg(0, std::ios::end)) {
+            content.reserve(static_cast<size_t>(std::max<std::streamoff>(file.tellg(), 0)));
+        }
+        file.clear();
+        file.seekg(0, std::ios::beg);
 
-        return buf.str();
+        while (file.read(buf, sizeof(buf)) || file.gcount() > 0) {
+            content.append(buf, static_cast<size_t>(file.gcount()));
+        }
+        file.close();
     }
 
 }
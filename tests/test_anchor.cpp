@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "yml/Diff.h"
+#include "yml/Frozen.h"
+#include "yml/Yml.h"
+
+#include <string>
+#include <utility>
+
+static const std::string CONTENT =
+    "defaults: &defaults\n"
+    "  timeout: 30\n"
+    "  retry:\n"
+    "    count: 3\n"
+    "port: &port 8080\n"
+    "services:\n"
+    "  api: *defaults\n"
+    "  web: *defaults\n"
+    "  admin:\n"
+    "    port: *port\n"
+    "ports:\n"
+    "  - *port\n"
+    "  - &other 9090\n"
+    "  - *other\n"
+    "unknown: *nope\n";
+
+TEST(Anchor, AliasesShareTheSubtree) {
+    const yml::Yml yml(CONTENT, true);
+    const yml::Node& defaults = yml["defaults"];
+    const yml::Node& api = yml["services"]["api"];
+
+    EXPECT_TRUE(api.children.isShared());
+    EXPECT_EQ(&api.children.getNodes(), &defaults.children.getNodes());
+    EXPECT_EQ(&yml["services"]["web"].children.getNodes(), &defaults.children.getNodes());
+    EXPECT_EQ(api["timeout"].as<int>(), 30);
+    EXPECT_EQ(yml.getNode("services.web.retry.count")->get().as<int>(), 3);
+    EXPECT_EQ(api.children, yml["defaults"].children);
+}
+
+TEST(Anchor, AliasRightAfterItsAnchor) {
+    const yml::Yml top("defaults: &defaults\n  timeout: 30\nweb: *defaults\n", true);
+    const yml::Yml nested("svc:\n  d: &d\n    t: 1\n  web: *d\n", true);
+
+    EXPECT_TRUE(top["web"].children.isShared());
+    EXPECT_EQ(top["web"]["timeout"].as<int>(), 30);
+    EXPECT_EQ(top["web"].value, "");
+    EXPECT_EQ(nested["svc"]["web"]["t"].as<int>(), 1);
+    EXPECT_EQ(&nested["svc"]["web"].children.getNodes(), &nested["svc"]["d"].children.getNodes());
+}
+
+TEST(Anchor, ScalarsAndLists) {
+    const yml::Yml yml(CONTENT, true);
+    const yml::Node& ports = yml["ports"];
+
+    EXPECT_EQ(yml["port"].as<int>(), 8080);
+    EXPECT_EQ(yml["services"]["admin"]["port"].as<int>(), 8080);
+    ASSERT_EQ(ports.children.size(), 3);
+    EXPECT_EQ(ports[0].as<int>(), 8080);
+    EXPECT_EQ(ports[1].as<int>(), 9090);
+    EXPECT_EQ(ports[2].as<int>(), 9090);
+    EXPECT_TRUE(ports[2].isList);
+    EXPECT_EQ(yml["unknown"].as<std::string>(), "*nope");
+}
+
+TEST(Anchor, ChangesDetach) {
+    yml::Yml yml(CONTENT, true);
+    yml::Node& web = yml["services"]["web"];
+    const uint64_t before = yml["defaults"].hash();
+
+    web.children.addNode(yml::Node("host", "example.org"));
+    EXPECT_FALSE(web.children.isShared());
+    EXPECT_EQ(web["timeout"].as<int>(), 30);
+    EXPECT_EQ(web["host"].as<std::string>(), "example.org");
+    EXPECT_FALSE(yml["defaults"].find("host"));
+    EXPECT_EQ(yml["defaults"].hash(), before);
+    EXPECT_TRUE(yml["services"]["api"].children.isShared());
+}
+
+TEST(Anchor, MutableAccessDetaches) {
+    yml::Yml yml(CONTENT, true);
+    const yml::Yml original(CONTENT, true);
+
+    yml["services"]["api"]["timeout"].setValue("5");
+    yml.getNode("services.web.retry.count")->get().setValue("7");
+    yml["services"]["api"][1]["count"].setValue("9");
+    EXPECT_FALSE(yml["services"]["api"].children.isShared());
+    EXPECT_FALSE(yml["services"]["web"].children.isShared());
+    EXPECT_EQ(std::as_const(yml)["defaults"]["timeout"].as<int>(), 30);
+    EXPECT_EQ(std::as_const(yml)["defaults"]["retry"]["count"].as<int>(), 3);
+    EXPECT_EQ(yml::diff(original, yml).changed, std::vector<std::string>({
+        "services.api.retry.count", "services.api.timeout", "services.web.retry.count"
+    }));
+
+    // Misses and const reads keep sharing.
+    yml::Yml untouched(CONTENT, true);
+
+    EXPECT_FALSE(untouched.getNode("services.api.nope"));
+    EXPECT_EQ(std::as_const(untouched)["services"]["api"]["timeout"].as<int>(), 30);
+    EXPECT_TRUE(untouched["services"]["api"].children.isShared());
+}
+
+TEST(Anchor, DiffSeesChangesToAliases) {
+    yml::Yml yml(CONTENT, true);
+    const yml::Yml original(CONTENT, true);
+
+    yml["services"]["web"].children.addNode(yml::Node("host", "example.org"));
+    EXPECT_EQ(yml::diff(original, yml).added, std::vector<std::string>{ "services.web.host" });
+    EXPECT_TRUE(yml::diff(original, yml).changed.empty());
+
+    yml["services"]["api"].children.share(); // Already shared: changes nothing.
+    yml["services"]["api"].children.detach();
+    EXPECT_EQ(yml::diff(original, yml).added.size(), 1);
+}
+
+TEST(Anchor, FrozenStoresSharedSubtreesOnce) {
+    const yml::Yml yml(CONTENT, true);
+    yml::Yml expanded(CONTENT, true);
+    const yml::FrozenYml frozen(yml.getTree());
+
+    expanded["services"]["api"].children.detach();
+    expanded["services"]["web"].children.detach();
+    EXPECT_EQ(frozen.getNode("services.api.timeout")->as<int>(), 30);
+    EXPECT_EQ(frozen.getNode("services.web.retry.count")->as<int>(), 3);
+    EXPECT_LT(frozen.footprint(), yml::FrozenYml(expanded.getTree()).footprint());
+}
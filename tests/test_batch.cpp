@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "yml/Batch.h"
+#include "yml/Exceptions/CouldNotOpenFile.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+TEST(Batch, LoadsEveryFileInOrder) {
+    const std::vector<std::string> paths = {
+        "../../tests/yml/1.yml",
+        "../../tests/yml/does_not_exist.yml",
+        "../../tests/yml/1.yml"
+    };
+    const auto results = yml::loadAll(paths, 2);
+
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_EQ(results[0].yml["hello"].as<std::string>(), "world");
+    EXPECT_FALSE(results[1].ok());
+    EXPECT_EQ(results[1].filepath, paths[1]);
+    EXPECT_THROW(results[1].rethrow(), yml::exception::CouldNotOpenFile);
+    EXPECT_TRUE(results[2].ok());
+}
+
+TEST(Batch, ParallelForVisitsEveryIndexOnce) {
+    std::vector<int> hits(1000, 0);
+
+    yml::parallelFor(hits.size(), 4, [&](const size_t i) { hits[i]++; });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 1000);
+}
+
+/**
+ * @brief   Sample file in the temporary directory, removed with the instance.
+ */
+struct Sample
+{
+    std::string path;
+
+    explicit Sample(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / name).string())
+    {
+        std::ofstream file(this->path);
+
+        for (int i = 0; i < 3000; ++i) {
+            file << "service" << i << ":\n  port: " << i << "\n  hosts:\n    - a" << i << "\n";
+        }
+        file << "last: line"; // No trailing newline
+    }
+
+    ~Sample() { std::filesystem::remove(this->path); }
+};
+
+TEST(Batch, FileReaderDeliversEveryByteInOrder) {
+    const Sample sample("yml_batch_reader.yml");
+    std::ifstream file(sample.path);
+    const std::string expected((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    for (const auto backend : { yml::io::Backend::BLOCKING, yml::io::Backend::IO_URING }) {
+        std::pmr::string content;
+        yml::io::FileReader reader(sample.path, content, backend, 4093);
+        size_t ready = 0;
+        size_t steps = 0;
+
+        for (size_t next; (next = reader.wait(ready)) != ready; ready = next) {
+            ++steps;
+        }
+        EXPECT_EQ(std::string_view(content), expected);
+        EXPECT_GE(steps, 1); // Or more, depending on how fast the file is read.
+    }
+
+    std::pmr::string missing;
+    EXPECT_THROW(yml::io::FileReader("does_not_exist.yml", missing), yml::exception::CouldNotOpenFile);
+}
+
+TEST(Batch, FileReaderDeliversBlockByBlock) {
+    const Sample sample("yml_batch_blocks.yml");
+    const size_t size = std::filesystem::file_size(sample.path);
+    constexpr size_t blockSize = 4093;
+
+    for (const auto backend : { yml::io::Backend::BLOCKING, yml::io::Backend::IO_URING }) {
+        std::pmr::string content;
+        std::vector<size_t> steps;  // Only written by the reading thread
+        yml::io::FileReader reader(sample.path, content, backend, blockSize, [&steps](const size_t ready) {
+            steps.push_back(ready);
+        });
+
+        for (size_t ready = 0, next; (next = reader.wait(ready)) != ready; ready = next) {}
+
+        // Every block is made available as soon as it is read. io_uring may
+        // complete several at once.
+        ASSERT_FALSE(steps.empty());
+        EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+        EXPECT_EQ(std::adjacent_find(steps.begin(), steps.end()), steps.end());
+        EXPECT_EQ(steps.back(), size);
+        if (reader.backend() == yml::io::Backend::BLOCKING) {
+            EXPECT_EQ(steps.size(), (size + blockSize - 1) / blockSize);
+            EXPECT_EQ(steps.front(), blockSize);
+        }
+    }
+}
+
+TEST(Batch, AsyncLoadMatchesSyncLoad) {
+    const Sample sample("yml_batch_async.yml");
+    const yml::Yml sync(sample.path);
+
+    for (const auto backend : { yml::io::Backend::BLOCKING, yml::io::Backend::IO_URING }) {
+        const yml::Yml async = yml::loadAsync(sample.path, backend).get();
+
+        EXPECT_TRUE(async.getTree() == sync.getTree());
+        EXPECT_EQ(async["service2999"]["port"].as<int>(), 2999);
+        EXPECT_EQ(async["last"].as<std::string>(), "line");
+    }
+    EXPECT_THROW(yml::loadAsync("does_not_exist.yml").get(), yml::exception::CouldNotOpenFile);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "yml/Yml.h"
+
+static const std::string CONTENT =
+    "ports:\n"
+    "  - 80\n"
+    "  - 443\n"
+    "  - 80\n"
+    "  - 8080\n"
+    "weights:\n"
+    "  - 0.5\n"
+    "  - -1.25\n"
+    "  - 3\n"
+    "  - +2e3\n"
+    "broken:\n"
+    "  - 1\n"
+    "  - 2\n"
+    "  - two\n"
+    "  - 4\n";
+
+TEST(Bulk, ListsKeepOrderAndDuplicates) {
+    const yml::Yml yml(CONTENT, true);
+    const yml::Node& ports = yml["ports"];
+
+    ASSERT_EQ(ports.children.size(), 4);
+    EXPECT_EQ(ports[0].as<int>(), 80);
+    EXPECT_EQ(ports[2].as<int>(), 80);
+    EXPECT_EQ(ports[3].as<int>(), 8080);
+    EXPECT_TRUE(ports[1].isList);
+}
+
+TEST(Bulk, AsVector) {
+    const yml::Yml yml(CONTENT, true);
+
+    EXPECT_EQ(yml["ports"].asVector<int>(), (std::vector<int>{ 80, 443, 80, 8080 }));
+    EXPECT_EQ(yml["ports"].asVector<uint16_t>(), (std::vector<uint16_t>{ 80, 443, 80, 8080 }));
+    EXPECT_EQ(yml["weights"].asVector<double>(), (std::vector<double>{ 0.5, -1.25, 3.0, 2000.0 }));
+    EXPECT_THROW(yml["weights"].asVector<int>(), yml::exception::InvalidNodeType);
+    EXPECT_EQ(yml.freeze()["ports"].asVector<long>(), (std::vector<long>{ 80, 443, 80, 8080 }));
+}
+
+TEST(Bulk, CopyToReportsFirstBadElement) {
+    const yml::Yml yml(CONTENT, true);
+    std::vector<int> out(8, -1);
+
+    const yml::node::BulkResult broken = yml["broken"].copyTo(std::span(out));
+    EXPECT_FALSE(broken.ok());
+    EXPECT_EQ(broken.bad, 2);
+    EXPECT_EQ(broken.count, 2);
+    EXPECT_EQ(out[1], 2);
+
+    const yml::node::BulkResult partial = yml["ports"].copyTo(std::span(out).first(2));
+    EXPECT_TRUE(partial.ok());
+    EXPECT_EQ(partial.count, 2);
+    EXPECT_EQ(out[1], 443);
+
+    EXPECT_EQ(yml.freeze()["broken"].copyTo(std::span(out)).bad, 2);
+
+    int number = 0;
+    EXPECT_TRUE(yml::node::parseNumber("+7", number));
+    EXPECT_EQ(number, 7);
+    EXPECT_FALSE(yml::node::parseNumber("+-1", number));
+}
+
+TEST(Bulk, WideMappingsAreIndexed) {
+    std::string content;
+
+    for (int i = 0; i < 50; ++i) {
+        content += "key" + std::to_string(i) + ": " + std::to_string(i) + "\n";
+    }
+    yml::Yml yml(content, true);
+
+    EXPECT_EQ(yml.getTree()[0].name, "key0");
+    EXPECT_EQ(yml.getTree()[49].name, "key49");
+    EXPECT_EQ(yml["key31"].as<int>(), 31);
+    yml.seal();
+    EXPECT_EQ(yml["key17"].as<int>(), 17);
+    EXPECT_FALSE(yml.getNode("key50"));
+}
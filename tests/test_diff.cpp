@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "yml/Diff.h"
+
+static const std::string OLD =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 8080\n"
+    "  tls:\n"
+    "    enabled: true\n"
+    "database:\n"
+    "  user: admin\n"
+    "cache:\n"
+    "  size: 64\n";
+
+static const std::string NEW =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 9090\n"
+    "  tls:\n"
+    "    enabled: true\n"
+    "database:\n"
+    "  user: admin\n"
+    "metrics:\n"
+    "  enabled: false\n";
+
+TEST(Diff, Identical) {
+    const yml::Yml a(OLD, true);
+    const yml::Yml b(OLD, true);
+
+    EXPECT_EQ(a.getTree().hash(), b.getTree().hash());
+    EXPECT_TRUE(yml::diff(a, b).empty());
+}
+
+TEST(Diff, AddedRemovedChanged) {
+    const yml::Yml a(OLD, true);
+    const yml::Yml b(NEW, true);
+    const yml::Diff d = yml::diff(a, b);
+
+    EXPECT_EQ(d.added, std::vector<std::string>{ "metrics" });
+    EXPECT_EQ(d.removed, std::vector<std::string>{ "cache" });
+    EXPECT_EQ(d.changed, std::vector<std::string>{ "server.port" });
+    EXPECT_EQ(a["database"].hash(), b["database"].hash());
+    EXPECT_NE(a["server"].hash(), b["server"].hash());
+}
+
+TEST(Diff, FingerprintsFollowMutations) {
+    yml::Yml a(OLD, true);
+    const yml::Yml b(OLD, true);
+    const uint64_t before = a.getTree().hash();
+
+    EXPECT_TRUE(a["server"] == b["server"]);
+    EXPECT_EQ(std::hash<yml::Node>{}(a["server"]), b["server"].hash());
+
+    a["server"]["tls"].children.addNode(yml::Node("verify", "false"));
+    EXPECT_NE(a.getTree().hash(), before);
+    EXPECT_FALSE(a["server"] == b["server"]);
+    EXPECT_TRUE(a["database"] == b["database"]);
+
+    yml::Node& port = a["server"]["port"];
+    port.setValue("9090");
+    EXPECT_EQ(port.type, yml::node::INTEGER);
+    EXPECT_EQ(yml::diff(b, a).changed, std::vector<std::string>{ "server.port" });
+
+    const yml::Node copy = a["server"];
+    EXPECT_TRUE(copy == a["server"]);
+    port.setValue("8080");
+    EXPECT_FALSE(copy == a["server"]);
+}
+
+TEST(Diff, DirectWritesNeedInvalidation) {
+    yml::Yml a(OLD, true);
+    const yml::Yml b(OLD, true);
+    yml::Node& port = a["server"]["port"];
+
+    // Writing to the field bypasses the cache...
+    port.value = "9090";
+    EXPECT_TRUE(yml::diff(b, a).empty());
+
+    // ...until it is dropped.
+    port.invalidateHash();
+    EXPECT_EQ(yml::diff(b, a).changed, std::vector<std::string>{ "server.port" });
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "yml/Yml.h"
+
+static const std::string CONTENT =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 8080\n"
+    "  tls:\n"
+    "    enabled: true\n"
+    "client:\n"
+    "  host: localhost\n"
+    "name: demo\n"
+    "ratio: 0.5\n";
+
+TEST(Frozen, SameReadApi) {
+    const yml::FrozenYml frozen = yml::Yml(CONTENT, true).freeze();
+
+    EXPECT_EQ(frozen["name"].as<std::string>(), "demo");
+    EXPECT_DOUBLE_EQ(frozen["ratio"].as<double>(), 0.5);
+    EXPECT_EQ(frozen["server"]["port"].as<int>(), 8080);
+    EXPECT_TRUE(frozen["server"]["tls"]["enabled"].as<bool>());
+    EXPECT_EQ(frozen["client"]["host"].as<std::string>(), "localhost");
+    EXPECT_THROW(frozen["server"]["missing"], std::out_of_range);
+    EXPECT_THROW(frozen["server"]["host"].as<int>(), yml::exception::InvalidNodeType);
+}
+
+TEST(Frozen, ChildrenAndPaths) {
+    const yml::FrozenYml frozen = yml::Yml(CONTENT, true).freeze();
+    const yml::FrozenNode server = frozen["server"];
+
+    ASSERT_EQ(server.size(), 3);
+    for (size_t i = 0; i < server.size(); ++i) {
+        EXPECT_EQ(server[server[i].name()].value(), server[i].value());
+    }
+    EXPECT_EQ(frozen.getNode("server.tls.enabled")->value(), "true");
+    EXPECT_FALSE(frozen.getNode("server.nope.enabled"));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "yml/Yml.h"
+
+#include <memory_resource>
+#include <string_view>
+
+static const std::string CONTENT =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 8080\n"
+    "  tls:\n"
+    "    enabled: true\n"
+    "name: demo\n"
+    "ratio: 0.5\n";
+
+TEST(Lookup, StringView) {
+    yml::Yml yml(CONTENT, true);
+    constexpr std::string_view key = "server.port";
+
+    EXPECT_EQ(yml["server"][key.substr(7)].as<int>(), 8080);
+    EXPECT_EQ(yml.getNode(key)->get().as<int>(), 8080);
+    EXPECT_TRUE(yml.getNode("server.tls.enabled")->get().as<bool>());
+}
+
+TEST(Lookup, Sealed) {
+    yml::Yml yml(CONTENT, true);
+
+    yml.seal();
+    EXPECT_EQ(yml["name"].as<std::string>(), "demo");
+    EXPECT_EQ(yml["server"]["host"].as<std::string>(), "localhost");
+    EXPECT_TRUE(yml["server"]["tls"]["enabled"].as<bool>());
+    EXPECT_THROW(yml["missing"], std::out_of_range);
+    EXPECT_THROW(yml["server"]["missing"], std::out_of_range);
+}
+
+TEST(Lookup, PerfectHashIsMinimalAndCollisionFree) {
+    std::vector<std::string> names;
+    std::vector<std::string_view> keys;
+    yml::PerfectHash hash;
+
+    for (int i = 0; i < 5000; ++i) {
+        names.push_back("key" + std::to_string(i));
+    }
+    keys.assign(names.begin(), names.end());
+
+    ASSERT_TRUE(hash.build(keys));
+    std::vector<bool> used(keys.size(), false);
+    for (const auto key : keys) {
+        const size_t slot = hash.slot(key);
+
+        ASSERT_LT(slot, keys.size());
+        EXPECT_FALSE(used[slot]);
+        used[slot] = true;
+    }
+}
+
+TEST(Lookup, NonThrowing) {
+    const yml::Yml yml(CONTENT, true);
+
+    EXPECT_FALSE(yml.getNode("missing"));
+    EXPECT_FALSE(yml.getNode("server.missing.port"));
+    EXPECT_EQ(yml.tryGet<int>("server.port"), 8080);
+    EXPECT_EQ(yml.tryGet<double>("server.port"), 8080.0);
+    EXPECT_EQ(yml.tryGet<double>("ratio"), 0.5);
+    EXPECT_EQ(yml.tryGet<bool>("server.tls.enabled"), true);
+    EXPECT_FALSE(yml.tryGet<int>("server.host"));
+    EXPECT_FALSE(yml.tryGet<int>("ratio"));
+    EXPECT_FALSE(yml.tryGet<std::string>("server.nope"));
+    EXPECT_EQ(yml["server"].tryGet<std::string>("host"), "localhost");
+    EXPECT_FALSE(yml["server"].tryGet<std::string>("nope"));
+    EXPECT_FALSE(yml["server"].find("nope"));
+    EXPECT_EQ(yml::node::tryConvert<int>("+1", yml::node::INTEGER), 1);
+    EXPECT_FALSE(yml::node::tryConvert<int>("+-1", yml::node::INTEGER));
+    EXPECT_FALSE(yml::node::tryConvert<double>("+-1.5", yml::node::DOUBLE));
+
+    // Only strings allocate.
+    static_assert(noexcept(yml.tryGet<int>("server.port")));
+    static_assert(!noexcept(yml.tryGet<std::string>("server.host")));
+}
+
+TEST(Lookup, MemoryResource) {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::memory_resource* const resource = &arena;
+
+    {
+        yml::Yml yml(CONTENT, true, YML_NESTING_SPACES, resource);
+        const yml::Node& tls = yml["server"]["tls"];
+
+        EXPECT_EQ(yml.getResource(), resource);
+        EXPECT_EQ(tls.get_allocator().resource(), resource);
+        EXPECT_EQ(tls["enabled"].name.get_allocator().resource(), resource);
+        EXPECT_TRUE(tls["enabled"].as<bool>());
+
+        const yml::Node copy = tls;
+        EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+        EXPECT_TRUE(copy["enabled"].as<bool>());
+    }
+    arena.release();
+}
+
+TEST(Lookup, NumberDetection) {
+    for (const std::string_view value : { "inf", "nan", "-inf", "infinity-mode", "nancy", "inf.0", "nan.x", ".inf", "-.nan", "+-1", "+-1.5" }) {
+        EXPECT_EQ(yml::Node("key", value).type, yml::node::STRING) << value;
+    }
+    for (const std::string_view value : { "1.5", "-0.5", "+2.0", ".5", "3.x" }) {
+        EXPECT_EQ(yml::Node("key", value).type, yml::node::DOUBLE) << value;
+    }
+    EXPECT_EQ(yml::Node("key", "-12").type, yml::node::INTEGER);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "yml/Diff.h"
+#include "yml/Overlay.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+static const std::string BASE =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 8080\n"
+    "  tls:\n"
+    "    enabled: false\n"
+    "debug: true\n"
+    "name: base\n";
+
+TEST(Overlay, FallsThroughToTheBase) {
+    const auto base = std::make_shared<const yml::Yml>(BASE, true);
+    yml::Overlay overlay(base);
+
+    overlay.set("server.port", "9090");
+    overlay.set("server.tls.cert", "/etc/cert.pem");
+    overlay.set("limits.cpu.cores", "4");
+    overlay.remove("debug");
+
+    EXPECT_EQ(overlay.tryGet<int>("server.port"), 9090);
+    EXPECT_EQ(overlay.tryGet("server.host"), "localhost");
+    EXPECT_EQ(overlay.tryGet<bool>("server.tls.enabled"), false);
+    EXPECT_EQ(overlay.tryGet("server.tls.cert"), "/etc/cert.pem");
+    EXPECT_EQ(overlay.tryGet<int>("limits.cpu.cores"), 4);
+    EXPECT_TRUE(overlay.getNode("limits.cpu"));
+    EXPECT_FALSE(overlay.getNode("debug"));
+    EXPECT_EQ(overlay.size(), 4);
+
+    // The base is shared, not modified.
+    EXPECT_EQ((*base)["server"]["port"].as<int>(), 8080);
+    EXPECT_TRUE((*base)["debug"].as<bool>());
+}
+
+TEST(Overlay, ChangesBelowAChangedPath) {
+    const auto base = std::make_shared<const yml::Yml>(BASE, true);
+    yml::Overlay overlay(base);
+
+    overlay.remove("server");
+    EXPECT_FALSE(overlay.getNode("server.host"));
+    overlay.set("server.host", "example.org");
+    EXPECT_EQ(overlay.tryGet("server.host"), "example.org");
+    EXPECT_FALSE(overlay.getNode("server.port"));
+    EXPECT_EQ(overlay.size(), 1);
+
+    overlay.set("server", (*base)["server"]);
+    overlay.set("server.port", "1");
+    EXPECT_EQ(overlay.tryGet("server.host"), "localhost");
+    EXPECT_EQ(overlay.tryGet<int>("server.port"), 1);
+    EXPECT_EQ(overlay.size(), 1);
+}
+
+TEST(Overlay, AncestorsAreMerged) {
+    const auto base = std::make_shared<const yml::Yml>(BASE, true);
+    const auto lower = std::make_shared<yml::Overlay>(base);
+
+    lower->set("server.tls.enabled", "true");
+
+    yml::Overlay overlay(lower);
+
+    overlay.set("server.port", "9090");
+    overlay.remove("server.host");
+
+    const yml::Node& server = overlay.getNode("server")->get();
+
+    EXPECT_EQ(server.tryGet<int>("port"), 9090);
+    EXPECT_FALSE(server.find("host"));
+    EXPECT_EQ(server["tls"].tryGet<bool>("enabled"), true);
+    EXPECT_EQ(&overlay.getNode("server")->get(), &server); // Built once
+    EXPECT_EQ(overlay.getNode("server.tls")->get().tryGet<bool>("enabled"), true);
+    EXPECT_EQ((*base)["server"]["port"].as<int>(), 8080);
+
+    overlay.set("server.tls.enabled", "false");
+    EXPECT_EQ(overlay.getNode("server")->get()["tls"].tryGet<bool>("enabled"), false);
+    overlay.set("server", "flat");
+    EXPECT_EQ(overlay.tryGet("server"), "flat");
+    EXPECT_FALSE(overlay.getNode("server.port"));
+    EXPECT_EQ(overlay.size(), 1);
+}
+
+TEST(Overlay, UntouchedSiblingsStayShared) {
+    const auto base = std::make_shared<const yml::Yml>(BASE, true);
+    const auto lower = std::make_shared<yml::Overlay>(base);
+
+    lower->set("server.port", "9090");
+
+    yml::Overlay overlay(lower);
+
+    overlay.set("server.host", "example.org");
+
+    const yml::Tree& tls = (*base)["server"]["tls"].children;
+
+    for (const yml::Overlay* layer : { lower.get(), &overlay }) {
+        const yml::Node& server = layer->getNode("server")->get();
+
+        EXPECT_TRUE(server["tls"].children.isShared());
+        EXPECT_EQ(&server["tls"].children.getNodes(), &tls.getNodes());
+    }
+    EXPECT_EQ(overlay.tryGet("server.host"), "example.org");
+    EXPECT_EQ(overlay.tryGet<int>("server.port"), 9090);
+}
+
+TEST(Overlay, LayersAndFlatten) {
+    const auto base = std::make_shared<const yml::Yml>(BASE, true);
+    const auto production = std::make_shared<yml::Overlay>(base);
+
+    production->set("server.tls.enabled", "true");
+    production->set("name", "production");
+
+    yml::Overlay tenant(production);
+
+    tenant.set("name", "acme");
+    tenant.remove("debug");
+    EXPECT_EQ(tenant.tryGet<bool>("server.tls.enabled"), true);
+    EXPECT_EQ(tenant.tryGet("name"), "acme");
+    EXPECT_EQ(production->tryGet("name"), "production");
+
+    const yml::FrozenYml frozen = tenant.flatten();
+
+    EXPECT_EQ(frozen["name"].as<std::string>(), "acme");
+    EXPECT_TRUE(frozen["server"]["tls"]["enabled"].as<bool>());
+    EXPECT_EQ(frozen["server"]["port"].as<int>(), 8080);
+    EXPECT_FALSE(frozen.getNode("debug"));
+    EXPECT_TRUE((*base)["debug"].as<bool>());
+}
+
+TEST(Overlay, EraseDetachesOnlyOnAHit) {
+    const std::string content = "defaults: &defaults\n  timeout: 30\nweb: *defaults\n";
+    yml::Yml yml(content, true);
+    const yml::Yml original(content, true);
+    yml::Tree& web = yml["web"].children;
+
+    EXPECT_FALSE(web.erase("nope"));
+    EXPECT_TRUE(web.isShared());
+    EXPECT_TRUE(web.erase("timeout"));
+    EXPECT_FALSE(web.isShared());
+    EXPECT_TRUE(web.empty());
+    EXPECT_EQ(std::as_const(yml)["defaults"]["timeout"].as<int>(), 30);
+    EXPECT_EQ(yml::diff(original, yml).removed, std::vector<std::string>{ "web.timeout" });
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "yml/Query.h"
+
+#include <algorithm>
+
+static const std::string CONTENT =
+    "services:\n"
+    "  web:\n"
+    "    port: 80\n"
+    "    tls:\n"
+    "      port: 443\n"
+    "  db:\n"
+    "    port: 5432\n"
+    "  cache:\n"
+    "    size: 64\n"
+    "backends:\n"
+    "  - name: alpha\n"
+    "  - name: beta\n"
+    "  - name: gamma\n"
+    "ports:\n"
+    "  - 80\n"
+    "  - 443\n";
+
+static std::vector<std::string> values(const std::vector<const yml::Node*>& nodes)
+{
+    std::vector<std::string> result;
+
+    for (const yml::Node* node : nodes) {
+        result.emplace_back(node->value);
+    }
+    return result;
+}
+
+TEST(Query, Wildcards) {
+    const yml::Yml yml(CONTENT, true);
+    std::vector<const yml::Node*> matches;
+
+    EXPECT_EQ(yml::Query("services.*.port").evaluate(yml, matches), 2);
+    EXPECT_EQ(values(matches), (std::vector<std::string>{ "80", "5432" }));
+
+    matches.clear();
+    yml::Query("services.**.port").evaluate(yml, matches);
+    std::vector<std::string> ports = values(matches);
+    std::sort(ports.begin(), ports.end());
+    EXPECT_EQ(ports, (std::vector<std::string>{ "443", "5432", "80" }));
+
+    matches.clear();
+    yml::Query("**").evaluate(yml["services"]["cache"], matches);
+    EXPECT_EQ(values(matches), (std::vector<std::string>{ "64" }));
+}
+
+TEST(Query, ListsAndIndices) {
+    const yml::Yml yml(CONTENT, true);
+    std::vector<const yml::Node*> matches;
+
+    yml::Query("backends.name").evaluate(yml, matches);
+    EXPECT_EQ(values(matches), (std::vector<std::string>{ "alpha", "beta", "gamma" }));
+
+    matches.clear();
+    yml::Query("backends[1]").evaluate(yml, matches);
+    EXPECT_EQ(values(matches), (std::vector<std::string>{ "beta" }));
+
+    matches.clear();
+    yml::Query("ports[*]").evaluate(yml, matches);
+    EXPECT_EQ(values(matches), (std::vector<std::string>{ "80", "443" }));
+
+    matches.clear();
+    EXPECT_EQ(yml::Query("ports[7]").evaluate(yml, matches), 0);
+    EXPECT_EQ(yml::Query("missing.*").evaluate(yml, matches), 0);
+}
+
+TEST(Query, InvalidPatterns) {
+    EXPECT_THROW(yml::Query(""), yml::exception::InvalidQuery);
+    EXPECT_THROW(yml::Query("a..b"), yml::exception::InvalidQuery);
+    EXPECT_THROW(yml::Query("a[1"), yml::exception::InvalidQuery);
+    EXPECT_THROW(yml::Query("a[x]"), yml::exception::InvalidQuery);
+    EXPECT_THROW(yml::Query("a[1]b"), yml::exception::InvalidQuery);
+    EXPECT_NO_THROW(yml::Query("a[1][2].**.*"));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "yml/Exceptions/SchemaViolation.h"
+#include "yml/Yml.h"
+
+#include <string>
+
+static const std::string SCHEMA =
+    "server:\n"
+    "  host: string required\n"
+    "  port: integer required min=1 max=65535\n"
+    "  tls: object\n"
+    "server.tls.enabled: boolean required\n"
+    "ports: list\n"
+    "ports.*: integer min=1\n"
+    "ratio: number max=1\n"
+    "name: string required\n";
+
+static const std::string VALID =
+    "server:\n"
+    "  host: localhost\n"
+    "  port: 8080\n"
+    "  tls:\n"
+    "    enabled: true\n"
+    "ports:\n"
+    "  - 80\n"
+    "  - 443\n"
+    "ratio: 1\n"
+    "name: demo\n"
+    "extra: ignored\n";
+
+static const std::string INVALID =
+    "server:\n"                 // 1
+    "  port: 70000\n"           // 2
+    "  tls:\n"                  // 3
+    "    enabled: maybe\n"      // 4
+    "\n"                        // 5
+    "ports:\n"                  // 6
+    "  - 80\n"                  // 7
+    "  - 0\n"                   // 8
+    "ratio: 1.5\n";             // 9
+
+TEST(Schema, Valid) {
+    const yml::Schema schema(yml::Yml(SCHEMA, true));
+    yml::Yml yml;
+
+    EXPECT_TRUE(yml.loadFromRawContent(VALID, schema).empty());
+    EXPECT_EQ(yml["server"]["port"].as<int>(), 8080);
+    EXPECT_NO_THROW(yml.loadFromRawContent(VALID, schema, true));
+}
+
+TEST(Schema, CollectsViolationsWithLines) {
+    const yml::Schema schema(yml::Yml(SCHEMA, true));
+    yml::Yml yml;
+    const auto violations = yml.loadFromRawContent(INVALID, schema);
+
+    ASSERT_EQ(violations.size(), 6);
+    EXPECT_EQ(violations[0].path, "server.port");
+    EXPECT_EQ(violations[0].line, 2);
+    EXPECT_EQ(violations[0].reason, "above the maximum of 65535");
+    EXPECT_EQ(violations[1].path, "server.tls.enabled");
+    EXPECT_EQ(violations[1].line, 4);
+    EXPECT_EQ(violations[1].reason, "expected boolean");
+    EXPECT_EQ(violations[2].path, "server.host");
+    EXPECT_EQ(violations[2].line, 1);
+    EXPECT_EQ(violations[2].reason, "missing");
+    EXPECT_EQ(violations[3].path, "ports.0");
+    EXPECT_EQ(violations[3].line, 8);
+    EXPECT_EQ(violations[4].path, "ratio");
+    EXPECT_EQ(violations[4].line, 9);
+    EXPECT_EQ(violations[5].path, "name");
+    EXPECT_EQ(violations[5].line, 0);
+    EXPECT_EQ(yml["ratio"].as<double>(), 1.5);
+}
+
+TEST(Schema, FailFast) {
+    yml::Schema schema;
+    yml::Yml yml;
+
+    schema.add("server.port", { yml::node::INTEGER, true, 1, 65535 });
+    schema.add("services.*.image", { yml::node::STRING, true });
+    EXPECT_THROW(yml.loadFromRawContent(INVALID, schema, true), yml::exception::SchemaViolation);
+    EXPECT_TRUE(yml.loadFromRawContent("server:\n  port: 80\n", schema, true).empty());
+    EXPECT_THROW(
+        yml.loadFromRawContent("server:\n  port: 80\nservices:\n  api:\n    replicas: 2\n", schema, true),
+        yml::exception::SchemaViolation
+    );
+    EXPECT_THROW(yml::Schema::parseRule("port", "integer between=1"), yml::exception::InvalidSchema);
+    EXPECT_THROW(yml::Schema::parseRule("port", "min=one"), yml::exception::InvalidSchema);
+    EXPECT_THROW(schema.add("", {}), yml::exception::InvalidSchema);
+}
+
+TEST(Schema, ChecksAliases) {
+    yml::Schema schema;
+    yml::Yml yml;
+    const std::string content =
+        "base: &base\n"         // 1
+        "  port: 500\n"         // 2
+        "  tls:\n"              // 3
+        "    enabled: yes\n"    // 4
+        "web: *base\n"          // 5
+        "admin:\n"              // 6
+        "  inner: *base\n";     // 7
+
+    schema.add("web.port", { yml::node::INTEGER, true, {}, 100 });
+    schema.add("web.host", { yml::node::STRING, true });
+    schema.add("web.tls.enabled", { yml::node::BOOLEAN });
+    schema.add("admin.inner.tls.cert", { yml::node::STRING, true });
+
+    const auto violations = yml.loadFromRawContent(content, schema);
+
+    ASSERT_EQ(violations.size(), 4);
+    EXPECT_EQ(violations[0].path, "web.port");
+    EXPECT_EQ(violations[0].line, 5);
+    EXPECT_EQ(violations[0].reason, "above the maximum of 100");
+    EXPECT_EQ(violations[1].path, "web.tls.enabled");
+    EXPECT_EQ(violations[1].reason, "expected boolean");
+    EXPECT_EQ(violations[2].path, "web.host");
+    EXPECT_EQ(violations[2].reason, "missing");
+    EXPECT_EQ(violations[3].path, "admin.inner.tls.cert");
+    EXPECT_EQ(violations[3].line, 7);
+    EXPECT_THROW(yml.loadFromRawContent(content, schema, true), yml::exception::SchemaViolation);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "yml/Stream.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <vector>
+
+static const std::string CONTENT =
+    "# Leading comment\n"
+    "---\n"
+    "event: start\n"
+    "id: 1\n"
+    "...\n"
+    "---\n"
+    "event: tick\n"
+    "id: 2\n"
+    "--- # Inline comment\n"
+    "event: stop\n"
+    "id: 3\n"
+    "...\n"
+    "\n"
+    "event: bare\n"
+    "id: 4";
+
+TEST(Stream, Index) {
+    const yml::Stream stream(CONTENT, true);
+
+    ASSERT_EQ(stream.size(), 4);
+    EXPECT_EQ(stream.raw(0), "event: start\nid: 1\n");
+    EXPECT_EQ(stream.raw(2), "event: stop\nid: 3\n");
+    EXPECT_EQ(stream.raw(3), "\nevent: bare\nid: 4");
+    EXPECT_EQ(stream.load(1)["event"].as<std::string>(), "tick");
+    EXPECT_EQ(stream.load(3)["id"].as<int>(), 4);
+    EXPECT_THROW(static_cast<void>(stream.raw(4)), std::out_of_range);
+    EXPECT_EQ(yml::Stream("", true).size(), 0);
+    EXPECT_EQ(yml::Stream("a: b", true).size(), 1);
+    EXPECT_EQ(yml::Stream("---\n---\na: b\n", true).size(), 2);
+}
+
+TEST(Stream, Iteration) {
+    const yml::Stream stream(CONTENT, true);
+    std::vector<int> ids;
+
+    stream.forEach([&ids](const size_t i, const yml::Yml& yml) {
+        EXPECT_EQ(yml["id"].as<int>(), static_cast<int>(i) + 1);
+        ids.push_back(yml["id"].as<int>());
+    });
+    EXPECT_EQ(ids, std::vector<int>({ 1, 2, 3, 4 }));
+}
+
+TEST(Stream, FileAndWorkers) {
+    std::string content;
+    std::pmr::synchronized_pool_resource pool;
+
+    for (int i = 0; i < 1000; ++i) {
+        content += "---\nid: " + std::to_string(i) + "\npayload:\n  size: " + std::to_string(i * 2) + "\n";
+    }
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "yml_stream.yml";
+    std::ofstream(path) << content;
+
+    const yml::Stream stream(path.string(), false, YML_NESTING_SPACES, &pool);
+
+    std::filesystem::remove(path); // The content is already loaded.
+    std::atomic<long> total = 0;
+
+    ASSERT_EQ(stream.size(), 1000);
+    stream.parallelForEach([&total](const size_t i, const yml::Yml& yml) {
+        EXPECT_EQ(yml["id"].as<int>(), static_cast<int>(i));
+        total += yml["payload"]["size"].as<int>();
+    }, 4);
+    EXPECT_EQ(total, 999 * 1000);
+    EXPECT_THROW(stream.parallelForEach([](size_t, const yml::Yml&) {
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "yml/Yml.h"
+
+#include "embedded.h" // Generated from yml/embedded.yml
+
+#include <vector>
+
+// Lookups need no parsing: they can even run at compile time.
+static_assert(config::embedded["server"]["port"].value() == "8080");
+static_assert(config::embedded["server"]["tls"]["enabled"].type() == yml::node::BOOLEAN);
+static_assert(!config::embedded.find("missing"));
+
+TEST(Yml2Cpp, SameReadApi) {
+    const yml::FrozenNode& embedded = config::embedded;
+
+    EXPECT_EQ(embedded["server"]["host"].as<std::string>(), "localhost");
+    EXPECT_EQ(embedded["server"]["port"].as<int>(), 8080);
+    EXPECT_TRUE(embedded["server"]["tls"]["enabled"].as<bool>());
+    EXPECT_DOUBLE_EQ(embedded["ratio"].as<double>(), 0.5);
+    EXPECT_EQ(embedded["ports"].asVector<int>(), std::vector<int>({ 80, 443 }));
+    EXPECT_THROW(embedded["server"]["missing"], std::out_of_range);
+}
+
+TEST(Yml2Cpp, MatchesRuntimeFreeze) {
+    const yml::FrozenYml frozen = yml::Yml("../../tests/yml/embedded.yml").freeze();
+
+    ASSERT_EQ(frozen.root().size(), config::embedded.size());
+    EXPECT_EQ(frozen["name"].value(), config::embedded["name"].value());
+    EXPECT_TRUE(std::equal(
+        frozen.getBlob().begin(), frozen.getBlob().end(),
+        config::embedded_tables::blob
+    ));
+}
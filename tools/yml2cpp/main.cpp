@@ -0,0 +1,160 @@
+/**
+ * yml2cpp - Embeds a YML file in a C++ header, as constexpr data.
+ *
+ * Usage: yml2cpp <input.yml> <output.h> <name> [namespace]
+ *
+ * The file is parsed and frozen at build time (see yml::FrozenYml). The
+ * header holds the tables of the frozen document and a constexpr
+ * yml::FrozenNode called <name> on top of them, so that reading the
+ * document costs no parsing, and no allocation, at startup:
+ *
+ *  #include "config.h"
+ *
+ *  const int port = config["server"]["port"].as<int>();
+ */
+
+#include "yml/Yml.h"
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+    constexpr size_t BLOB_LINE = 64; // Bytes of blob per line of output
+
+    std::string_view typeName(const yml::node::Type type)
+    {
+        switch (type) {
+            case yml::node::STRING:     return "yml::node::STRING";
+            case yml::node::INTEGER:    return "yml::node::INTEGER";
+            case yml::node::DOUBLE:     return "yml::node::DOUBLE";
+            case yml::node::BOOLEAN:    return "yml::node::BOOLEAN";
+            case yml::node::OBJECT:     return "yml::node::OBJECT";
+            case yml::node::LIST:       return "yml::node::LIST";
+            default:                    return "yml::node::UNKNOWN";
+        }
+    }
+
+    void writeBlob(std::ostream& out, const std::span<const char> blob, const std::string& indent)
+    {
+        char escape[8];
+
+        if (blob.empty()) {
+            out << indent << "\"\"";
+        }
+        for (size_t i = 0; i < blob.size(); ++i) {
+            const auto c = static_cast<unsigned char>(blob[i]);
+
+            if (i % BLOB_LINE == 0) {
+                out << (i == 0 ? "" : "\"\n") << indent << '"';
+            }
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (c >= 0x20 && c < 0x7f) {
+                out << c;
+            } else {
+                // Always three digits, so that no digit that follows is
+                // taken as part of the escape.
+                std::snprintf(escape, sizeof(escape), "\\%03o", c);
+                out << escape;
+            }
+        }
+        if (!blob.empty()) {
+            out << '"';
+        }
+    }
+
+    void writeHeader
+    (
+        std::ostream& out,
+        const yml::FrozenYml& frozen,
+        const std::string_view input,
+        const std::string_view name,
+        const std::string_view ns
+    )
+    {
+        const std::string indent = ns.empty() ? "" : "    ";
+        const std::string tables = std::string(name) + "_tables";
+
+        out << "// Generated by yml2cpp from " << input << ". Do not edit.\n"
+            << "\n"
+            << "#pragma once\n"
+            << "\n"
+            << "#include \"yml/Frozen.h\"\n"
+            << "\n";
+        if (!ns.empty()) {
+            out << "namespace " << ns << "\n{\n\n";
+        }
+
+        out << indent << "namespace " << tables << "\n"
+            << indent << "{\n"
+            << "\n"
+            << indent << "    inline constexpr yml::frozen::Record records[] = {\n";
+        for (const yml::frozen::Record& r : frozen.getRecords()) {
+            out << indent << "        { "
+                << r.nameOffset << ", " << r.nameSize << ", "
+                << r.valueOffset << ", " << r.valueSize << ", "
+                << r.firstChild << ", " << r.childCount << ", "
+                << r.seedOffset << "u, "
+                << typeName(r.type) << ", "
+                << (r.isList ? "true" : "false") << " },\n";
+        }
+        out << indent << "    };\n"
+            << "\n"
+            << indent << "    inline constexpr char blob[] =\n";
+        writeBlob(out, frozen.getBlob(), indent + "        ");
+        out << ";\n"
+            << "\n"
+            << indent << "    inline constexpr uint32_t seeds[] = {";
+        // An array cannot be empty: documents without any mapping get one
+        // unused seed.
+        if (frozen.getSeeds().empty()) {
+            out << " 0";
+        }
+        for (size_t i = 0; i < frozen.getSeeds().size(); ++i) {
+            out << (i % 8 == 0 ? "\n" + indent + "        " : " ") << frozen.getSeeds()[i] << "u,";
+        }
+        out << "\n" << indent << "    };\n"
+            << "\n"
+            << indent << "}\n"
+            << "\n"
+            << indent << "/// Root of " << input << ".\n"
+            << indent << "inline constexpr yml::FrozenNode " << name << "{\n"
+            << indent << "    yml::frozen::View{ " << tables << "::records, " << tables << "::blob, " << tables << "::seeds }\n"
+            << indent << "};\n";
+
+        if (!ns.empty()) {
+            out << "\n}\n";
+        }
+    }
+
+}
+
+int main(const int argc, const char* const argv[])
+{
+    if (argc < 4 || argc > 5) {
+        std::cerr << "Usage: " << argv[0] << " <input.yml> <output.h> <name> [namespace]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const yml::FrozenYml frozen = yml::Yml(argv[1]).freeze();
+        std::ofstream out(argv[2], std::ios::binary);
+
+        writeHeader(out, frozen, std::filesystem::path(argv[1]).filename().string(), argv[3], argc == 5 ? argv[4] : "");
+        if (!out.flush()) {
+            std::cerr << argv[0] << ": Could not write " << argv[2] << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}